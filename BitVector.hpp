@@ -0,0 +1,393 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <span>
+
+// Bit Kernels
+// Word-at-a-time loops over uint64_t bit blocks: population count with the popcnt instruction when
+// the CPU has it, and bulk AND/OR/XOR 256 bits per step with AVX2. Both are picked at run time
+// unless the build already targets them.
+class BitHelper {
+public:
+    using Word = std::uint64_t;
+
+    enum class Op { And, Or, Xor, AndNot };
+
+    static constexpr size_t count(const Word* words, const size_t n) noexcept {
+#if defined(VECTOR_HAS_AVX2_KERNEL) && !defined(__POPCNT__)
+        if (!std::is_constant_evaluated() && has_popcnt()) {
+            return count_popcnt(words, n);
+        }
+#endif
+        return count_words(words, n);
+    }
+
+    // dst[i] = dst[i] op src[i]
+    template <Op op>
+    static void combine(Word* dst, const Word* src, const size_t n) noexcept {
+        size_t i = 0;
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        if (n >= 4 && has_avx2()) {
+            i = combine_avx2<op>(dst, src, n);
+        }
+#endif
+        for (; i < n; ++i) {
+            dst[i] = apply<op>(dst[i], src[i]);
+        }
+    }
+
+private:
+    template <Op op>
+    static constexpr Word apply(const Word a, const Word b) noexcept {
+        if constexpr (op == Op::And) {
+            return a & b;
+        } else if constexpr (op == Op::Or) {
+            return a | b;
+        } else if constexpr (op == Op::Xor) {
+            return a ^ b;
+        } else {
+            return a & ~b;
+        }
+    }
+
+    // Four independent sums so consecutive popcounts do not wait on each other
+    static constexpr size_t count_words(const Word* words, const size_t n) noexcept {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            c0 += std::popcount(words[i]);
+            c1 += std::popcount(words[i + 1]);
+            c2 += std::popcount(words[i + 2]);
+            c3 += std::popcount(words[i + 3]);
+        }
+        for (; i < n; ++i) {
+            c0 += std::popcount(words[i]);
+        }
+        return c0 + c1 + c2 + c3;
+    }
+
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+    static bool has_popcnt() noexcept {
+        static const bool supported = __builtin_cpu_supports("popcnt");
+        return supported;
+    }
+
+    static bool has_avx2() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#endif
+    }
+
+    __attribute__((target("popcnt"))) static size_t count_popcnt(const Word* words, const size_t n) noexcept {
+        size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            c0 += static_cast<size_t>(_mm_popcnt_u64(words[i]));
+            c1 += static_cast<size_t>(_mm_popcnt_u64(words[i + 1]));
+            c2 += static_cast<size_t>(_mm_popcnt_u64(words[i + 2]));
+            c3 += static_cast<size_t>(_mm_popcnt_u64(words[i + 3]));
+        }
+        for (; i < n; ++i) {
+            c0 += static_cast<size_t>(_mm_popcnt_u64(words[i]));
+        }
+        return c0 + c1 + c2 + c3;
+    }
+
+    // Returns the number of words processed, a multiple of four
+    template <Op op>
+    __attribute__((target("avx2"))) static size_t combine_avx2(Word* dst, const Word* src, const size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+            __m256i r;
+            if constexpr (op == Op::And) {
+                r = _mm256_and_si256(a, b);
+            } else if constexpr (op == Op::Or) {
+                r = _mm256_or_si256(a, b);
+            } else if constexpr (op == Op::Xor) {
+                r = _mm256_xor_si256(a, b);
+            } else {
+                r = _mm256_andnot_si256(b, a);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+        }
+        return i;
+    }
+#endif
+};
+
+// Bit Vector
+// A growable sequence of bits packed 64 to a word, stored in a Vector<uint64_t> and so sharing its
+// growth policy and allocator support. Elements are accessed through proxy references; count(),
+// the find_first()/find_next() scan and the bitwise operators work a word (or four) at a time.
+//
+//   BitVector<> visited(node_count);
+//   visited[start] = true;
+//   for (size_t i = visited.find_first(); i != BitVector<>::npos; i = visited.find_next(i)) { ... }
+//
+// Bits past size() in the last word are kept clear, so whole words can be counted and compared.
+template <typename Allocator = DefaultAllocator<std::uint64_t>>
+class BitVector {
+public:
+    using Word = std::uint64_t;
+    using ValueType = bool;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using AllocatorType = Allocator;
+    using WordVector = Vector<Word, Allocator>;
+
+    static constexpr size_t word_bits = 64;
+    static constexpr SizeType npos = static_cast<SizeType>(-1);
+
+    // Proxy for one bit, valid until the BitVector reallocates
+    class Reference {
+        Word* word_;
+        Word mask_;
+
+        friend class BitVector;
+        constexpr Reference(Word* word, const Word mask) noexcept : word_(word), mask_(mask) {}
+
+    public:
+        constexpr operator bool() const noexcept { return (*word_ & mask_) != 0; }
+
+        constexpr Reference& operator=(const bool value) noexcept {
+            *word_ = (*word_ & ~mask_) | ((Word(0) - Word(value)) & mask_);
+            return *this;
+        }
+
+        constexpr Reference& operator=(const Reference& other) noexcept { return *this = static_cast<bool>(other); }
+
+        constexpr bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+        constexpr void flip() noexcept { *word_ ^= mask_; }
+    };
+
+private:
+    WordVector words_;
+    size_t size_;
+
+    static constexpr size_t words_for(const size_t bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+
+    static constexpr Word mask_of(const size_t index) noexcept { return Word(1) << (index % word_bits); }
+
+    // Clear the bits past size_ in the last word
+    constexpr void clear_tail() noexcept {
+        if (const size_t used = size_ % word_bits) {
+            words_[words_.size() - 1] &= ~Word(0) >> (word_bits - used);
+        }
+    }
+
+    // Index of the lowest set bit in bits, or in a later word
+    constexpr SizeType scan_from(size_t word, Word bits) const noexcept {
+        while (bits == 0) {
+            if (++word >= words_.size()) {
+                return npos;
+            }
+            bits = words_[word];
+        }
+        return word * word_bits + static_cast<size_t>(std::countr_zero(bits));
+    }
+
+    template <BitHelper::Op op>
+    BitVector& combine(const BitVector& other) {
+        if (size_ != other.size_) {
+            throw std::invalid_argument("BitVector sizes differ");
+        }
+        BitHelper::combine<op>(words_.data(), other.words_.data(), words_.size());
+        return *this;
+    }
+
+public:
+    constexpr BitVector() noexcept(std::is_nothrow_default_constructible_v<Allocator>) : words_(), size_(0) {}
+
+    constexpr explicit BitVector(const Allocator& alloc) : words_(alloc), size_(0) {}
+
+    constexpr explicit BitVector(const SizeType count, const bool value = false, const Allocator& alloc = Allocator())
+        : words_(alloc), size_(0) {
+        resize(count, value);
+    }
+
+    constexpr SizeType size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    constexpr SizeType capacity() const noexcept { return words_.capacity() * word_bits; }
+
+    // The packed words, lowest index in the least significant bit of the first word
+    constexpr const Word* data() const noexcept { return words_.data(); }
+    constexpr std::span<const Word> words() const noexcept { return {words_.data(), words_.size()}; }
+
+    constexpr Allocator get_allocator() const { return words_.get_allocator(); }
+
+    constexpr void reserve(const SizeType bits) { words_.reserve(words_for(bits)); }
+    constexpr void shrink_to_fit() { words_.shrink_to_fit(); }
+
+    constexpr void clear() noexcept {
+        words_.clear();
+        size_ = 0;
+    }
+
+    constexpr void resize(const SizeType new_size, const bool value = false) {
+        const Word fill = value ? ~Word(0) : Word(0);
+        if (new_size > size_ && value && size_ % word_bits != 0) {
+            words_[words_.size() - 1] |= ~Word(0) << (size_ % word_bits);
+        }
+        words_.resize(words_for(new_size), fill);
+        size_ = new_size;
+        clear_tail();
+    }
+
+    constexpr void push_back(const bool value) {
+        if (size_ % word_bits == 0) {
+            words_.push_back(Word(value));
+        } else {
+            words_[size_ / word_bits] |= Word(value) << (size_ % word_bits);
+        }
+        ++size_;
+    }
+
+    constexpr void pop_back() {
+        if (size_ == 0) {
+            throw std::out_of_range("Cannot pop from empty vector");
+        }
+        --size_;
+        if (size_ % word_bits == 0) {
+            words_.pop_back();
+        } else {
+            words_[size_ / word_bits] &= ~mask_of(size_);
+        }
+    }
+
+    constexpr Reference operator[](const SizeType index) noexcept {
+        return Reference(&words_[index / word_bits], mask_of(index));
+    }
+
+    constexpr bool operator[](const SizeType index) const noexcept { return test(index); }
+
+    constexpr Reference at(const SizeType index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    constexpr bool at(const SizeType index) const {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        return test(index);
+    }
+
+    constexpr bool front() const {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return test(0);
+    }
+
+    constexpr bool back() const {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return test(size_ - 1);
+    }
+
+    constexpr bool test(const SizeType index) const noexcept {
+        return (words_[index / word_bits] & mask_of(index)) != 0;
+    }
+
+    constexpr void set(const SizeType index, const bool value = true) noexcept { (*this)[index] = value; }
+    constexpr void reset(const SizeType index) noexcept { words_[index / word_bits] &= ~mask_of(index); }
+    constexpr void flip(const SizeType index) noexcept { words_[index / word_bits] ^= mask_of(index); }
+
+    // Whole-vector forms
+    constexpr void set() noexcept {
+        std::fill(words_.begin(), words_.end(), ~Word(0));
+        clear_tail();
+    }
+
+    constexpr void reset() noexcept { std::fill(words_.begin(), words_.end(), Word(0)); }
+
+    constexpr void flip() noexcept {
+        for (Word& word : words_) {
+            word = ~word;
+        }
+        clear_tail();
+    }
+
+    // Number of set bits
+    constexpr SizeType count() const noexcept { return BitHelper::count(words_.data(), words_.size()); }
+
+    constexpr bool any() const noexcept {
+        return std::any_of(words_.begin(), words_.end(), [](const Word word) { return word != 0; });
+    }
+
+    constexpr bool none() const noexcept { return !any(); }
+
+    constexpr bool all() const noexcept {
+        const size_t full = size_ / word_bits;
+        for (size_t i = 0; i < full; ++i) {
+            if (words_[i] != ~Word(0)) return false;
+        }
+        const size_t used = size_ % word_bits;
+        return used == 0 || words_[full] == ~Word(0) >> (word_bits - used);
+    }
+
+    // Index of the first set bit, or npos
+    constexpr SizeType find_first() const noexcept { return words_.empty() ? npos : scan_from(0, words_[0]); }
+
+    // Index of the first set bit after pos, or npos
+    constexpr SizeType find_next(const SizeType pos) const noexcept {
+        const size_t next = pos + 1;
+        if (pos == npos || next >= size_) {
+            return npos;
+        }
+        const size_t word = next / word_bits;
+        return scan_from(word, words_[word] & (~Word(0) << (next % word_bits)));
+    }
+
+    // Call func(index) for every set bit in increasing order
+    template <typename Func>
+    constexpr void for_each_set(Func&& func) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            for (Word bits = words_[w]; bits != 0; bits &= bits - 1) {
+                func(w * word_bits + static_cast<size_t>(std::countr_zero(bits)));
+            }
+        }
+    }
+
+    // Bitwise operators between vectors of equal size; std::invalid_argument otherwise
+    BitVector& operator&=(const BitVector& other) { return combine<BitHelper::Op::And>(other); }
+    BitVector& operator|=(const BitVector& other) { return combine<BitHelper::Op::Or>(other); }
+    BitVector& operator^=(const BitVector& other) { return combine<BitHelper::Op::Xor>(other); }
+
+    // Clear every bit that is set in other
+    BitVector& and_not(const BitVector& other) { return combine<BitHelper::Op::AndNot>(other); }
+
+    friend BitVector operator&(BitVector a, const BitVector& b) {
+        a &= b;
+        return a;
+    }
+
+    friend BitVector operator|(BitVector a, const BitVector& b) {
+        a |= b;
+        return a;
+    }
+
+    friend BitVector operator^(BitVector a, const BitVector& b) {
+        a ^= b;
+        return a;
+    }
+
+    constexpr void swap(BitVector& other) noexcept {
+        words_.swap(other.words_);
+        std::swap(size_, other.size_);
+    }
+
+    constexpr bool operator==(const BitVector& other) const {
+        return size_ == other.size_ && words_ == other.words_;
+    }
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "SegmentedVector.hpp"
+
+#include <atomic>
+
+// Concurrent Vector
+// Append-only vector that many threads can grow at once without a lock. A producer claims its
+// slots with a compare-exchange on the size, makes sure their segments exist (racing allocations are
+// settled with a compare-exchange) and constructs the elements in place. Segments never move, so
+// elements and references into the vector stay valid while others append.
+//
+// Every slot has a ready flag, stored with release once its element is constructed: operator[]
+// may read element i concurrently with appends as soon as published(i) is true, or once the
+// producer has handed i over by other means. size() counts claimed slots, some of which may
+// still be under construction. The allocator must be safe to call from several threads.
+// clear(), destruction and iteration need the producers to be finished.
+template <typename T, typename Allocator = DefaultAllocator<T>,
+          size_t FirstSegment = std::bit_floor(std::max<size_t>(1, 4096 / sizeof(T)))>
+class ConcurrentVector {
+    using Traits = AllocatorHelper<T, Allocator>;
+    using Layout = SegmentLayout<FirstSegment>;
+
+    // Slot states; a slot whose constructor threw stays empty and is skipped on destruction
+    static constexpr unsigned char slot_pending = 0;
+    static constexpr unsigned char slot_ready = 1;
+    static constexpr unsigned char slot_failed = 2;
+
+public:
+    static constexpr size_t max_segments = Layout::max_segments;
+
+private:
+    // Each segment is one allocation: its elements followed by their ready flags
+    std::atomic<T*> segments_[max_segments];
+    std::atomic<size_t> size_;
+    [[no_unique_address]] Allocator allocator_;
+
+    static constexpr size_t allocation_size(const size_t segment) noexcept {
+        const size_t elements = Layout::segment_size(segment);
+        return elements + (elements + sizeof(T) - 1) / sizeof(T);
+    }
+
+    static unsigned char* flags_of(T* segment_data, const size_t segment) noexcept {
+        return reinterpret_cast<unsigned char*>(segment_data + Layout::segment_size(segment));
+    }
+
+    static std::atomic_ref<unsigned char> flag(T* segment_data, const size_t segment, const size_t offset) noexcept {
+        return std::atomic_ref<unsigned char>(flags_of(segment_data, segment)[offset]);
+    }
+
+    // The segment, allocating it if nobody has yet
+    T* segment(const size_t k) {
+        T* existing = segments_[k].load(std::memory_order_acquire);
+        if (existing) return existing;
+
+        T* fresh = nullptr;
+        Traits::allocate(fresh, allocator_, allocation_size(k));
+        std::memset(flags_of(fresh, k), slot_pending, Layout::segment_size(k));
+        if (segments_[k].compare_exchange_strong(existing, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return fresh;
+        }
+        // Another thread won the race
+        Traits::deallocate(fresh, allocator_, allocation_size(k));
+        return existing;
+    }
+
+    // Slots the segment table can address: every segment together holds 2^digits - FirstSegment
+    static constexpr size_t max_elements = static_cast<size_t>(0) - FirstSegment;
+
+    // Claims only what the segment table can hold, so size_ never counts a slot it cannot address
+    size_t claim(const size_t count) {
+        size_t first = size_.load(std::memory_order_relaxed);
+        do {
+            if (count > max_elements - first) {
+                throw std::bad_array_new_length();
+            }
+        } while (!size_.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+        return first;
+    }
+
+    // Mark a claimed slot failed if its segment exists; never allocates, so it is safe while unwinding.
+    // A slot whose segment could not be allocated is not published either way.
+    void mark_failed(const size_t index) noexcept {
+        const size_t k = Layout::segment_of(index);
+        if (T* data = segments_[k].load(std::memory_order_acquire)) {
+            flag(data, k, Layout::offset_in(index, k)).store(slot_failed, std::memory_order_release);
+        }
+    }
+
+    // Construct slot index from args and publish it; on throw the slot is marked failed
+    template <typename... Args>
+    T& construct_at(const size_t index, Args&&... args) {
+        const size_t k = Layout::segment_of(index);
+        const size_t offset = Layout::offset_in(index, k);
+        T* data = nullptr;
+        try {
+            data = segment(k);
+            Traits::construct(data + offset, allocator_, std::forward<Args>(args)...);
+        } catch (...) {
+            mark_failed(index);
+            throw;
+        }
+        flag(data, k, offset).store(slot_ready, std::memory_order_release);
+        return data[offset];
+    }
+
+    template <typename Construct>
+    size_t grow_with(const size_t count, Construct&& construct) {
+        const size_t first = claim(count);
+        size_t i = first;
+        try {
+            for (; i < first + count; ++i) {
+                construct(i);
+            }
+        } catch (...) {
+            // The rest of the claimed block stays empty
+            for (++i; i < first + count; ++i) {
+                mark_failed(i);
+            }
+            throw;
+        }
+        return first;
+    }
+
+public:
+    using ValueType = T;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using AllocatorType = Allocator;
+
+    ConcurrentVector() noexcept(std::is_nothrow_default_constructible<Allocator>::value)
+        : segments_(), size_(0), allocator_(Allocator()) {}
+
+    explicit ConcurrentVector(const Allocator& alloc) noexcept : segments_(), size_(0), allocator_(alloc) {}
+
+    // Shared by address between threads; neither copied nor moved
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        clear();
+        for (size_t k = 0; k < max_segments; ++k) {
+            if (T* data = segments_[k].load(std::memory_order_relaxed)) {
+                Traits::deallocate(data, allocator_, allocation_size(k));
+            }
+        }
+    }
+
+    // Claimed slots, including ones still being constructed
+    SizeType size() const noexcept { return size_.load(std::memory_order_acquire); }
+    bool empty() const noexcept { return size() == 0; }
+
+    SizeType capacity() const noexcept {
+        size_t total = 0;
+        for (size_t k = 0; k < max_segments; ++k) {
+            if (segments_[k].load(std::memory_order_relaxed)) total += Layout::segment_size(k);
+        }
+        return total;
+    }
+
+    // True once element index (< size()) is constructed; its contents are then visible to the caller
+    bool published(const SizeType index) const noexcept {
+        const size_t k = Layout::segment_of(index);
+        T* data = segments_[k].load(std::memory_order_acquire);
+        return data && flag(data, k, Layout::offset_in(index, k)).load(std::memory_order_acquire) == slot_ready;
+    }
+
+    T& operator[](const SizeType index) noexcept {
+        const size_t k = Layout::segment_of(index);
+        return segments_[k].load(std::memory_order_acquire)[Layout::offset_in(index, k)];
+    }
+
+    const T& operator[](const SizeType index) const noexcept {
+        const size_t k = Layout::segment_of(index);
+        return segments_[k].load(std::memory_order_acquire)[Layout::offset_in(index, k)];
+    }
+
+    // Safe to call from any number of threads at once; the returned reference stays valid
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        return construct_at(claim(1), std::forward<Args>(args)...);
+    }
+
+    T& push_back(const T& value) { return emplace_back(value); }
+    T& push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // Claim count contiguous slots at once, value-initialized or copied from value; returns the
+    // index of the first
+    SizeType grow_by(const SizeType count) {
+        return grow_with(count, [this](const size_t i) { construct_at(i); });
+    }
+
+    SizeType grow_by(const SizeType count, const T& value) {
+        return grow_with(count, [this, &value](const size_t i) { construct_at(i, value); });
+    }
+
+    // Allocate every segment up to new_capacity elements; may run concurrently with appends
+    void reserve(const SizeType new_capacity) {
+        if (new_capacity == 0) return;
+        for (size_t k = 0, last = Layout::segment_of(new_capacity - 1); k <= last; ++k) {
+            segment(k);
+        }
+    }
+
+    // Not thread-safe: destroys the elements and keeps the segments
+    void clear() noexcept {
+        const size_t count = size_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i) {
+            const size_t k = Layout::segment_of(i);
+            T* data = segments_[k].load(std::memory_order_relaxed);
+            const size_t offset = Layout::offset_in(i, k);
+            if (data && flag(data, k, offset).load(std::memory_order_relaxed) == slot_ready) {
+                Traits::destroy(data + offset, allocator_);
+            }
+            if (data) flag(data, k, offset).store(slot_pending, std::memory_order_relaxed);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+    Allocator get_allocator() const {
+        return allocator_;
+    }
+
+    // Visit every published element in index order; not meant to race with appends
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (size_t i = 0, count = size(); i < count; ++i) {
+            if (published(i)) func((*this)[i]);
+        }
+    }
+};
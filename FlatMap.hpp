@@ -0,0 +1,383 @@
+#pragma once
+
+#include "FlatSet.hpp"
+
+// Flat Map
+// Sorted unique keys with their mapped values, each in its own Vector column: searching touches
+// only the densely packed keys, and the values are reached by index once the key is found.
+// Single inserts block-move both columns; bulk_insert() sorts just the batch and merges it
+// backwards into the room appended at the end, so rebuilding from a large batch moves every
+// element a bounded number of times instead of shifting once per key.
+//
+// Insertion and erasure invalidate iterators. When a batch holds a key that is already present,
+// or holds it twice, the first entry wins, as with std::map::insert.
+template <typename K, typename V, typename Compare = std::less<K>, typename KeyAllocator = DefaultAllocator<K>,
+          typename ValueAllocator = DefaultAllocator<V>>
+class FlatMap {
+public:
+    using KeyType = K;
+    using MappedType = V;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using KeyCompare = Compare;
+    using KeyAllocatorType = KeyAllocator;
+    using ValueAllocatorType = ValueAllocator;
+    using KeyContainerType = Vector<K, KeyAllocator>;
+    using MappedContainerType = Vector<V, ValueAllocator>;
+    using Reference = std::pair<const K&, V&>;
+    using ConstReference = std::pair<const K&, const V&>;
+
+    static constexpr bool is_transparent = requires { typename Compare::is_transparent; };
+
+    // Random-access iterator over (key, value) rows of the two columns
+    template <bool IsConst>
+    class EntryIterator {
+    public:
+        using Owner = std::conditional_t<IsConst, const FlatMap, FlatMap>;
+        using value_type = std::pair<K, V>;
+        using reference = std::conditional_t<IsConst, ConstReference, Reference>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        EntryIterator() noexcept : owner_(nullptr), index_(0) {}
+        EntryIterator(Owner* owner, const size_t index) noexcept : owner_(owner), index_(index) {}
+
+        // Mutable iterators convert to const ones
+        operator EntryIterator<true>() const noexcept { return EntryIterator<true>(owner_, index_); }
+
+        reference operator*() const noexcept { return owner_->entry(index_); }
+        reference operator[](const difference_type n) const noexcept { return owner_->entry(index_ + n); }
+
+        const K& key() const noexcept { return owner_->keys_[index_]; }
+        auto& value() const noexcept { return owner_->values_[index_]; }
+
+        EntryIterator& operator++() noexcept { ++index_; return *this; }
+        EntryIterator operator++(int) noexcept { EntryIterator old = *this; ++index_; return old; }
+        EntryIterator& operator--() noexcept { --index_; return *this; }
+        EntryIterator operator--(int) noexcept { EntryIterator old = *this; --index_; return old; }
+        EntryIterator& operator+=(const difference_type n) noexcept { index_ += n; return *this; }
+        EntryIterator& operator-=(const difference_type n) noexcept { index_ -= n; return *this; }
+
+        friend EntryIterator operator+(EntryIterator it, const difference_type n) noexcept { return it += n; }
+        friend EntryIterator operator+(const difference_type n, EntryIterator it) noexcept { return it += n; }
+        friend EntryIterator operator-(EntryIterator it, const difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const EntryIterator& a, const EntryIterator& b) noexcept {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const EntryIterator& a, const EntryIterator& b) noexcept { return a.index_ == b.index_; }
+        friend auto operator<=>(const EntryIterator& a, const EntryIterator& b) noexcept { return a.index_ <=> b.index_; }
+
+        size_t index() const noexcept { return index_; }
+
+    private:
+        Owner* owner_;
+        size_t index_;
+    };
+
+    using Iterator = EntryIterator<false>;
+    using ConstIterator = EntryIterator<true>;
+
+private:
+    KeyContainerType keys_;
+    MappedContainerType values_;
+    [[no_unique_address]] Compare compare_;
+
+    template <typename Key>
+    size_t lower_index(const Key& key) const {
+        return FlatSearch::lower_bound(keys_.data(), keys_.size(), key, compare_);
+    }
+
+    template <typename Key>
+    bool matches(const size_t index, const Key& key) const {
+        return index < keys_.size() && !compare_(key, keys_[index]);
+    }
+
+    Reference entry(const size_t index) noexcept { return {keys_[index], values_[index]}; }
+    ConstReference entry(const size_t index) const noexcept { return {keys_[index], values_[index]}; }
+
+    // Insert a row at index, keeping the two columns the same length if the second insert throws
+    template <typename Key, typename... Args>
+    void insert_row(const size_t index, Key&& key, Args&&... args) {
+        keys_.emplace_at(keys_.begin() + index, std::forward<Key>(key));
+        try {
+            values_.emplace_at(values_.begin() + index, std::forward<Args>(args)...);
+        } catch (...) {
+            keys_.erase(keys_.begin() + index);
+            throw;
+        }
+    }
+
+    template <typename Key, typename... Args>
+    std::pair<Iterator, bool> try_emplace_impl(Key&& key, Args&&... args) {
+        const size_t index = lower_index(key);
+        if (matches(index, key)) {
+            return {Iterator(this, index), false};
+        }
+        insert_row(index, std::forward<Key>(key), std::forward<Args>(args)...);
+        return {Iterator(this, index), true};
+    }
+
+    // Keep the first of each run of equivalent keys, compacting both columns
+    void remove_duplicates() {
+        const size_t n = keys_.size();
+        size_t out = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (out > 0 && !compare_(keys_[out - 1], keys_[i])) continue;
+            if (out != i) {
+                keys_[out] = std::move(keys_[i]);
+                values_[out] = std::move(values_[i]);
+            }
+            ++out;
+        }
+        keys_.erase(keys_.begin() + out, keys_.end());
+        values_.erase(values_.begin() + out, values_.end());
+    }
+
+public:
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp, const KeyAllocator& key_alloc = KeyAllocator(),
+                     const ValueAllocator& value_alloc = ValueAllocator())
+        : keys_(key_alloc), values_(value_alloc), compare_(comp) {}
+
+    explicit FlatMap(const KeyAllocator& key_alloc, const ValueAllocator& value_alloc = ValueAllocator())
+        : keys_(key_alloc), values_(value_alloc), compare_() {}
+
+    // Any range of pair-like entries, in any order and with duplicate keys
+    template <std::ranges::input_range R>
+        requires(!std::is_same_v<std::remove_cvref_t<R>, FlatMap>)
+    explicit FlatMap(R&& r, const Compare& comp = Compare(), const KeyAllocator& key_alloc = KeyAllocator(),
+                     const ValueAllocator& value_alloc = ValueAllocator())
+        : keys_(key_alloc), values_(value_alloc), compare_(comp) {
+        bulk_insert(std::forward<R>(r));
+    }
+
+    SizeType size() const noexcept { return keys_.size(); }
+    bool empty() const noexcept { return keys_.empty(); }
+
+    Iterator begin() noexcept { return Iterator(this, 0); }
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator cbegin() const noexcept { return ConstIterator(this, 0); }
+
+    Iterator end() noexcept { return Iterator(this, keys_.size()); }
+    ConstIterator end() const noexcept { return ConstIterator(this, keys_.size()); }
+    ConstIterator cend() const noexcept { return ConstIterator(this, keys_.size()); }
+
+    // The columns themselves: keys are read-only, values may be modified in place
+    std::span<const K> keys() const noexcept { return {keys_.data(), keys_.size()}; }
+    std::span<V> values() noexcept { return {values_.data(), values_.size()}; }
+    std::span<const V> values() const noexcept { return {values_.data(), values_.size()}; }
+
+    KeyCompare key_comp() const { return compare_; }
+    KeyAllocator get_key_allocator() const { return keys_.get_allocator(); }
+    ValueAllocator get_value_allocator() const { return values_.get_allocator(); }
+
+    void reserve(SizeType n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    void clear() {
+        keys_.clear();
+        values_.clear();
+    }
+
+    // Lookup; heterogeneous keys are accepted when Compare is transparent (e.g. std::less<>)
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator find(const Key& key) {
+        const size_t index = lower_index(key);
+        return matches(index, key) ? Iterator(this, index) : end();
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    ConstIterator find(const Key& key) const {
+        const size_t index = lower_index(key);
+        return matches(index, key) ? ConstIterator(this, index) : end();
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    bool contains(const Key& key) const {
+        return matches(lower_index(key), key);
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    SizeType count(const Key& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator lower_bound(const Key& key) {
+        return Iterator(this, lower_index(key));
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    ConstIterator lower_bound(const Key& key) const {
+        return ConstIterator(this, lower_index(key));
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator upper_bound(const Key& key) {
+        return Iterator(this, FlatSearch::upper_bound(keys_.data(), keys_.size(), key, compare_));
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    ConstIterator upper_bound(const Key& key) const {
+        return ConstIterator(this, FlatSearch::upper_bound(keys_.data(), keys_.size(), key, compare_));
+    }
+
+    V& at(const K& key) {
+        const size_t index = lower_index(key);
+        if (!matches(index, key)) {
+            throw std::out_of_range("Key not found");
+        }
+        return values_[index];
+    }
+
+    const V& at(const K& key) const {
+        const size_t index = lower_index(key);
+        if (!matches(index, key)) {
+            throw std::out_of_range("Key not found");
+        }
+        return values_[index];
+    }
+
+    // The value for key, value-initialized first if the key is new
+    V& operator[](const K& key) { return try_emplace_impl(key).first.value(); }
+    V& operator[](K&& key) { return try_emplace_impl(std::move(key)).first.value(); }
+
+    // Insert key with a value built from args, unless the key is present
+    template <typename... Args>
+    std::pair<Iterator, bool> try_emplace(const K& key, Args&&... args) {
+        return try_emplace_impl(key, std::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    std::pair<Iterator, bool> try_emplace(K&& key, Args&&... args) {
+        return try_emplace_impl(std::move(key), std::forward<Args>(args)...);
+    }
+
+    std::pair<Iterator, bool> insert(const K& key, const V& value) { return try_emplace_impl(key, value); }
+    std::pair<Iterator, bool> insert(K&& key, V&& value) { return try_emplace_impl(std::move(key), std::move(value)); }
+
+    template <typename Value>
+    std::pair<Iterator, bool> insert_or_assign(const K& key, Value&& value) {
+        auto result = try_emplace_impl(key, std::forward<Value>(value));
+        if (!result.second) {
+            result.first.value() = std::forward<Value>(value);
+        }
+        return result;
+    }
+
+    // Merge a batch of pair-like entries, O(m log m + n) for m entries into n. The batch is
+    // gathered into one contiguous run of rows and sorted there, then merged backwards into room
+    // appended at the end of both columns, so each existing row moves at most once.
+    template <std::ranges::input_range R>
+    void bulk_insert(R&& r) {
+        // The batch draws on the key allocator, so a map living in an arena stays in it
+        using BatchAllocator = typename RebindAllocator<KeyAllocator, std::pair<K, V>>::Type;
+        Vector<std::pair<K, V>, BatchAllocator> batch{BatchAllocator(keys_.get_allocator())};
+        if constexpr (std::ranges::sized_range<R>) {
+            batch.reserve(std::ranges::size(r));
+        }
+        // A batch passed as an owning rvalue (not a view) gives its entries up
+        constexpr bool take_entries = !std::is_lvalue_reference_v<R> && !std::ranges::view<std::remove_cvref_t<R>>;
+        for (auto&& entry : r) {
+            if constexpr (take_entries) {
+                batch.emplace_back(std::get<0>(std::move(entry)), std::get<1>(std::move(entry)));
+            } else {
+                // get<> of a forwarded pair moves only the member it names
+                batch.emplace_back(std::get<0>(std::forward<decltype(entry)>(entry)),
+                                   std::get<1>(std::forward<decltype(entry)>(entry)));
+            }
+        }
+        const size_t m = batch.size();
+        if (m == 0) return;
+
+        // Stable, so of equivalent keys in the batch the first stays ahead
+        std::stable_sort(batch.begin(), batch.end(),
+                         [this](const auto& a, const auto& b) { return compare_(a.first, b.first); });
+
+        if constexpr (!std::is_nothrow_move_constructible_v<K> || !std::is_nothrow_move_assignable_v<K> ||
+                      !std::is_nothrow_move_constructible_v<V> || !std::is_nothrow_move_assignable_v<V>) {
+            // A move that throws halfway through the merge would leave the columns torn
+            for (auto& [key, value] : batch) {
+                try_emplace_impl(std::move(key), std::move(value));
+            }
+            return;
+        } else {
+            const size_t old_size = keys_.size();
+            keys_.append_uninitialized(m);
+            values_.append_uninitialized(m);
+            K* keys = keys_.data();
+            V* values = values_.data();
+
+            // Fill from the back with the larger of the two remaining tails. Slots past
+            // old_size are raw storage and are constructed, the rest are assigned. Of equivalent
+            // keys the existing one ends up first, so remove_duplicates() keeps it.
+            size_t existing = old_size;
+            size_t pending = m;
+            size_t write = old_size + m;
+            auto put = [&](K& key, V& value) {
+                --write;
+                if (write >= old_size) {
+                    ::new (static_cast<void*>(keys + write)) K(std::move(key));
+                    ::new (static_cast<void*>(values + write)) V(std::move(value));
+                } else {
+                    keys[write] = std::move(key);
+                    values[write] = std::move(value);
+                }
+            };
+            while (pending > 0) {
+                auto& next = batch[pending - 1];
+                if (existing > 0 && compare_(next.first, keys[existing - 1])) {
+                    --existing;
+                    put(keys[existing], values[existing]);
+                } else {
+                    --pending;
+                    put(next.first, next.second);
+                }
+            }
+            keys_.commit_append(m);
+            values_.commit_append(m);
+            remove_duplicates();
+        }
+    }
+
+    SizeType erase(const K& key) {
+        const size_t index = lower_index(key);
+        if (!matches(index, key)) return 0;
+        keys_.erase(keys_.begin() + index);
+        values_.erase(values_.begin() + index);
+        return 1;
+    }
+
+    Iterator erase(ConstIterator pos) {
+        const size_t index = pos.index();
+        keys_.erase(keys_.begin() + index);
+        values_.erase(values_.begin() + index);
+        return Iterator(this, index);
+    }
+
+    void swap(FlatMap& other) noexcept {
+        keys_.swap(other.keys_);
+        values_.swap(other.values_);
+        using std::swap;
+        swap(compare_, other.compare_);
+    }
+
+    bool operator==(const FlatMap& other) const { return keys_ == other.keys_ && values_ == other.values_; }
+};
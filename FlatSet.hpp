@@ -0,0 +1,211 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <span>
+
+// Flat Search
+// Lower bound over a sorted array without a data-dependent branch: each step halves the window
+// with a conditional move, so lookups do not stall on mispredictions
+class FlatSearch {
+public:
+    template <typename T, typename Key, typename Compare>
+    static size_t lower_bound(const T* data, size_t n, const Key& key, const Compare& comp) {
+        if (n == 0) return 0;
+        const T* base = data;
+        while (n > 1) {
+            const size_t half = n / 2;
+            base = comp(base[half], key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - data) + (comp(*base, key) ? 1 : 0);
+    }
+
+    template <typename T, typename Key, typename Compare>
+    static size_t upper_bound(const T* data, const size_t n, const Key& key, const Compare& comp) {
+        return lower_bound(data, n, key, [&comp](const T& element, const Key& k) { return !comp(k, element); });
+    }
+};
+
+// Flat Set
+// Sorted, unique keys in one contiguous Vector: lookups are a binary search over adjacent memory
+// instead of a walk through tree nodes. A single insert shifts the tail with one block move;
+// bulk_insert() appends a whole batch, sorts only the new tail and merges it with the existing
+// keys, for O(n log n) in total instead of one shift per key.
+//
+// Insertion and erasure invalidate iterators, like Vector's. When a batch holds a key that is
+// already present, or holds it twice, the first copy wins, as with std::set::insert.
+template <typename K, typename Compare = std::less<K>, typename Allocator = DefaultAllocator<K>>
+class FlatSet {
+public:
+    using KeyType = K;
+    using ValueType = K;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using KeyCompare = Compare;
+    using AllocatorType = Allocator;
+    using ContainerType = Vector<K, Allocator>;
+    // Keys are never modified in place: that could break the ordering
+    using Iterator = const K*;
+    using ConstIterator = const K*;
+
+    static constexpr bool is_transparent = requires { typename Compare::is_transparent; };
+
+private:
+    ContainerType keys_;
+    [[no_unique_address]] Compare compare_;
+
+    template <typename Key>
+    size_t lower_index(const Key& key) const {
+        return FlatSearch::lower_bound(keys_.data(), keys_.size(), key, compare_);
+    }
+
+    template <typename Key>
+    bool matches(const size_t index, const Key& key) const {
+        return index < keys_.size() && !compare_(key, keys_[index]);
+    }
+
+public:
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator()) : keys_(alloc), compare_(comp) {}
+
+    explicit FlatSet(const Allocator& alloc) : keys_(alloc), compare_() {}
+
+    // Any range of keys, in any order and with duplicates
+    template <std::ranges::input_range R>
+        requires(!std::is_same_v<std::remove_cvref_t<R>, FlatSet>)
+    explicit FlatSet(R&& r, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : keys_(alloc), compare_(comp) {
+        bulk_insert(std::forward<R>(r));
+    }
+
+    SizeType size() const noexcept { return keys_.size(); }
+    SizeType capacity() const noexcept { return keys_.capacity(); }
+    bool empty() const noexcept { return keys_.empty(); }
+
+    Iterator begin() const noexcept { return keys_.data(); }
+    Iterator cbegin() const noexcept { return keys_.data(); }
+    Iterator end() const noexcept { return keys_.data() + keys_.size(); }
+    Iterator cend() const noexcept { return keys_.data() + keys_.size(); }
+
+    const K* data() const noexcept { return keys_.data(); }
+    std::span<const K> keys() const noexcept { return {keys_.data(), keys_.size()}; }
+
+    const K& operator[](SizeType index) const noexcept { return keys_[index]; }
+
+    KeyCompare key_comp() const { return compare_; }
+    Allocator get_allocator() const { return keys_.get_allocator(); }
+
+    void reserve(SizeType n) { keys_.reserve(n); }
+    void shrink_to_fit() { keys_.shrink_to_fit(); }
+    void clear() { keys_.clear(); }
+
+    // Lookup; heterogeneous keys are accepted when Compare is transparent (e.g. std::less<>)
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator lower_bound(const Key& key) const {
+        return begin() + lower_index(key);
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator upper_bound(const Key& key) const {
+        return begin() + FlatSearch::upper_bound(keys_.data(), keys_.size(), key, compare_);
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    Iterator find(const Key& key) const {
+        const size_t index = lower_index(key);
+        return matches(index, key) ? begin() + index : end();
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    bool contains(const Key& key) const {
+        return matches(lower_index(key), key);
+    }
+
+    template <typename Key = K>
+        requires(std::is_same_v<Key, K> || is_transparent)
+    SizeType count(const Key& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Insert key unless an equivalent one is present; returns its position and whether it was new
+    template <typename... Args>
+    std::pair<Iterator, bool> emplace(Args&&... args) {
+        K key(std::forward<Args>(args)...);
+        const size_t index = lower_index(key);
+        if (matches(index, key)) {
+            return {begin() + index, false};
+        }
+        keys_.emplace_at(keys_.begin() + index, std::move(key));
+        return {begin() + index, true};
+    }
+
+    std::pair<Iterator, bool> insert(const K& key) {
+        const size_t index = lower_index(key);
+        if (matches(index, key)) {
+            return {begin() + index, false};
+        }
+        keys_.emplace_at(keys_.begin() + index, key);
+        return {begin() + index, true};
+    }
+
+    std::pair<Iterator, bool> insert(K&& key) {
+        return emplace(std::move(key));
+    }
+
+    // Append the batch, sort it stably, merge it into the existing keys and drop duplicates.
+    // Costs O(m log m + n) for m new keys, against O(m * n) for m single inserts.
+    template <std::ranges::input_range R>
+    void bulk_insert(R&& r) {
+        const size_t old_size = keys_.size();
+        keys_.append_range(std::forward<R>(r));
+        if (keys_.size() == old_size) return;
+
+        K* first = keys_.data();
+        K* middle = first + old_size;
+        K* last = first + keys_.size();
+        std::stable_sort(middle, last, compare_);
+        // A batch that lands wholly after the existing keys needs no merge
+        if (old_size > 0 && compare_(*middle, middle[-1])) {
+            std::inplace_merge(first, middle, last, compare_);
+        }
+        // Stable throughout, so of equivalent keys the existing or earliest one comes first
+        K* unique_end = std::unique(first, last, [this](const K& a, const K& b) { return !compare_(a, b); });
+        keys_.erase(keys_.begin() + (unique_end - first), keys_.end());
+    }
+
+    SizeType erase(const K& key) {
+        const size_t index = lower_index(key);
+        if (!matches(index, key)) return 0;
+        keys_.erase(keys_.begin() + index);
+        return 1;
+    }
+
+    Iterator erase(ConstIterator pos) {
+        const size_t index = static_cast<size_t>(pos - begin());
+        keys_.erase(keys_.begin() + index);
+        return begin() + index;
+    }
+
+    Iterator erase(ConstIterator first, ConstIterator last) {
+        const size_t index = static_cast<size_t>(first - begin());
+        keys_.erase(keys_.begin() + index, keys_.begin() + (last - begin()));
+        return begin() + index;
+    }
+
+    void swap(FlatSet& other) noexcept {
+        keys_.swap(other.keys_);
+        using std::swap;
+        swap(compare_, other.compare_);
+    }
+
+    // Hand the sorted keys over, leaving the set empty
+    ContainerType extract() && { return std::move(keys_); }
+
+    bool operator==(const FlatSet& other) const { return keys_ == other.keys_; }
+};
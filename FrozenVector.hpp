@@ -0,0 +1,153 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <atomic>
+#include <span>
+
+// Frozen Vector
+// An immutable, reference-counted Vector for read-mostly data shared by many threads. freeze()
+// takes a Vector's buffer without copying it; copies of the FrozenVector then share that one
+// buffer and cost an atomic increment. thaw() hands back a mutable Vector, copying the elements
+// only if another FrozenVector still shares them.
+//
+//   FrozenVector<Entry> table = freeze(std::move(entries));
+//   std::thread reader([snapshot = table] { lookup(snapshot); });
+//
+// Like std::shared_ptr, distinct FrozenVector objects may be copied and destroyed from any
+// thread; a single object must not be assigned to while others read it.
+template <typename T, typename Allocator = DefaultAllocator<T>>
+class FrozenVector {
+public:
+    using ValueType = T;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using VectorType = Vector<T, Allocator>;
+    using ConstIterator = const T*;
+    using Iterator = ConstIterator;
+
+private:
+    // One allocation per frozen buffer: the count and the vector that owns the elements, which
+    // is only ever mutated by thaw() once nothing else refers to it
+    struct Shared {
+        std::atomic<size_t> references;
+        VectorType elements;
+    };
+
+    Shared* shared_;
+
+    void release() noexcept {
+        if (shared_ && shared_->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete shared_;
+        }
+        shared_ = nullptr;
+    }
+
+public:
+    FrozenVector() noexcept : shared_(nullptr) {}
+
+    // Take v's buffer; elements only move one by one if v keeps them inline
+    explicit FrozenVector(VectorType&& v) : shared_(v.empty() ? nullptr : new Shared{{1}, std::move(v)}) {}
+
+    FrozenVector(const FrozenVector& other) noexcept : shared_(other.shared_) {
+        if (shared_) {
+            shared_->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    FrozenVector(FrozenVector&& other) noexcept : shared_(other.shared_) {
+        other.shared_ = nullptr;
+    }
+
+    FrozenVector& operator=(const FrozenVector& other) noexcept {
+        FrozenVector(other).swap(*this);
+        return *this;
+    }
+
+    FrozenVector& operator=(FrozenVector&& other) noexcept {
+        FrozenVector(std::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~FrozenVector() { release(); }
+
+    void swap(FrozenVector& other) noexcept { std::swap(shared_, other.shared_); }
+
+    // A mutable copy of the contents; the FrozenVector is unchanged
+    VectorType thaw() const& {
+        return shared_ ? VectorType(shared_->elements) : VectorType();
+    }
+
+    // Give the contents back as a mutable Vector, stealing the buffer when no other FrozenVector
+    // shares it and copying it when one does; *this is left empty
+    VectorType thaw() && {
+        if (!shared_) return VectorType();
+        if (shared_->references.load(std::memory_order_acquire) != 1) {
+            VectorType copy(shared_->elements);
+            release();
+            return copy;
+        }
+        // Sole owner: nobody else can observe the elements any more
+        VectorType stolen(std::move(shared_->elements));
+        delete shared_;
+        shared_ = nullptr;
+        return stolen;
+    }
+
+    // Number of FrozenVectors sharing the buffer; 0 when empty
+    size_t use_count() const noexcept {
+        return shared_ ? shared_->references.load(std::memory_order_relaxed) : 0;
+    }
+
+    SizeType size() const noexcept { return shared_ ? shared_->elements.size() : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    const T* data() const noexcept { return shared_ ? shared_->elements.data() : nullptr; }
+
+    ConstIterator begin() const noexcept { return data(); }
+    ConstIterator cbegin() const noexcept { return data(); }
+    ConstIterator end() const noexcept { return data() + size(); }
+    ConstIterator cend() const noexcept { return data() + size(); }
+
+    std::span<const T> span() const noexcept { return {data(), size()}; }
+
+    const T& operator[](SizeType index) const noexcept { return data()[index]; }
+
+    const T& at(SizeType index) const {
+        if (index >= size()) {
+            throw std::out_of_range("Index out of range");
+        }
+        return data()[index];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return data()[0];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return data()[size() - 1];
+    }
+
+    bool operator==(const FrozenVector& other) const {
+        if (shared_ == other.shared_) return true;
+        if (size() != other.size()) return false;
+        if (empty()) return true;
+        return shared_->elements == other.shared_->elements;
+    }
+
+    bool operator==(const VectorType& other) const {
+        return shared_ ? shared_->elements == other : other.empty();
+    }
+};
+
+// Freeze v without copying its elements
+template <typename T, typename Allocator>
+FrozenVector<T, Allocator> freeze(Vector<T, Allocator>&& v) {
+    return FrozenVector<T, Allocator>(std::move(v));
+}
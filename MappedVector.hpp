@@ -0,0 +1,336 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <cerrno>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// File Header
+// Fixed-size prefix of every mapped vector file; the elements follow at data_offset
+struct MappedVectorHeader {
+    static constexpr uint64_t file_magic = 0x524f544345564d56;  // "VMVECTOR"
+    static constexpr uint32_t file_version = 1;
+
+    uint64_t magic;
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t type_checksum;
+    uint64_t size;
+    uint64_t capacity;
+};
+
+// FNV-1a of the compiler's spelling of T, so a file written for one element type is rejected
+// when opened as another of the same size
+template <typename T>
+uint64_t mapped_type_checksum() noexcept {
+    const std::string_view name = std::source_location::current().function_name();
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    }
+    return hash;
+}
+
+// Memory-Mapped Vector
+// A vector of trivially copyable elements living in a file; opening it maps the file instead of
+// reading and parsing it. MappedVector<const T> opens the file read-only and gives zero-copy access;
+// MappedVector<T> opens (or creates) it read-write, and growth extends the file. Changes reach the
+// file through the shared mapping; sync() forces them to disk.
+//
+//   MappedVector<Entry> out("index.bin");
+//   out.push_back(entry);
+//   out.sync();
+//   MappedVector<const Entry> in("index.bin");
+template <typename T>
+class MappedVector {
+public:
+    using ValueType = std::remove_const_t<T>;
+    using Iterator = T*;
+    using ConstIterator = const T*;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+
+    static constexpr bool read_only = std::is_const_v<T>;
+
+    static_assert(std::is_trivially_copyable_v<ValueType>, "MappedVector: elements are stored as raw bytes");
+    static_assert(alignof(ValueType) <= 4096, "MappedVector: mappings are only page aligned");
+
+    static constexpr size_t data_offset = std::max<size_t>(64, alignof(ValueType));
+
+private:
+    int fd_;
+    unsigned char* map_;
+    size_t mapped_bytes_;
+    MappedVectorHeader* header_;
+    T* buffer_;
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    static size_t file_bytes(const size_t capacity) noexcept {
+        return data_offset + capacity * sizeof(ValueType);
+    }
+
+    void map(const size_t bytes) {
+        const int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: cannot map file");
+        }
+        set_mapping(p, bytes);
+    }
+
+    void set_mapping(void* p, const size_t bytes) noexcept {
+        map_ = static_cast<unsigned char*>(p);
+        mapped_bytes_ = bytes;
+        header_ = reinterpret_cast<MappedVectorHeader*>(map_);
+        buffer_ = reinterpret_cast<T*>(map_ + data_offset);
+    }
+
+    void unmap() noexcept {
+        if (map_) {
+            ::munmap(map_, mapped_bytes_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+        map_ = nullptr;
+        header_ = nullptr;
+        buffer_ = nullptr;
+        mapped_bytes_ = 0;
+    }
+
+    void validate(const size_t file_size) const {
+        if (file_size < sizeof(MappedVectorHeader) || header_->magic != MappedVectorHeader::file_magic ||
+            header_->version != MappedVectorHeader::file_version) {
+            throw std::runtime_error("MappedVector: not a mapped vector file");
+        }
+        if (header_->element_size != sizeof(ValueType) || header_->type_checksum != mapped_type_checksum<ValueType>()) {
+            throw std::runtime_error("MappedVector: file holds a different element type");
+        }
+        if (header_->size > header_->capacity || header_->capacity > (file_size - data_offset) / sizeof(ValueType)) {
+            throw std::runtime_error("MappedVector: file is truncated");
+        }
+    }
+
+    // Extend the file and the mapping to new_capacity elements
+    void grow_file(const size_t new_capacity) requires(!read_only) {
+        const size_t bytes = file_bytes(new_capacity);
+        if (::ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            fail("MappedVector: cannot grow file");
+        }
+#if defined(__linux__)
+        void* p = ::mremap(map_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: cannot remap file");
+        }
+        set_mapping(p, bytes);
+#else
+        // Map the grown file before dropping the old mapping, which stays valid if this fails
+        const int protection = read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = ::mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            fail("MappedVector: cannot map file");
+        }
+        ::munmap(map_, mapped_bytes_);
+        set_mapping(p, bytes);
+#endif
+        header_->capacity = new_capacity;
+    }
+
+public:
+    explicit MappedVector(const std::string& path) : fd_(-1), map_(nullptr), mapped_bytes_(0), header_(nullptr), buffer_(nullptr) {
+        fd_ = ::open(path.c_str(), read_only ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            fail("MappedVector: cannot open " + path);
+        }
+        try {
+            struct stat info;
+            if (::fstat(fd_, &info) != 0) {
+                fail("MappedVector: cannot stat " + path);
+            }
+            size_t file_size = static_cast<size_t>(info.st_size);
+
+            if constexpr (!read_only) {
+                if (file_size == 0) {
+                    // New file: write an empty header
+                    file_size = file_bytes(0);
+                    if (::ftruncate(fd_, static_cast<off_t>(file_size)) != 0) {
+                        fail("MappedVector: cannot initialize " + path);
+                    }
+                    map(file_size);
+                    *header_ = MappedVectorHeader{MappedVectorHeader::file_magic, MappedVectorHeader::file_version,
+                                                  sizeof(ValueType), mapped_type_checksum<ValueType>(), 0, 0};
+                    return;
+                }
+            }
+            if (file_size < data_offset) {
+                throw std::runtime_error("MappedVector: not a mapped vector file");
+            }
+            map(file_size);
+            validate(file_size);
+        } catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(other.fd_), map_(other.map_), mapped_bytes_(other.mapped_bytes_), header_(other.header_), buffer_(other.buffer_) {
+        other.fd_ = -1;
+        other.map_ = nullptr;
+        other.mapped_bytes_ = 0;
+        other.header_ = nullptr;
+        other.buffer_ = nullptr;
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            std::swap(fd_, other.fd_);
+            std::swap(map_, other.map_);
+            std::swap(mapped_bytes_, other.mapped_bytes_);
+            std::swap(header_, other.header_);
+            std::swap(buffer_, other.buffer_);
+        }
+        return *this;
+    }
+
+    ~MappedVector() { unmap(); }
+
+    // The read interface matches Vector
+    SizeType size() const noexcept { return header_ ? header_->size : 0; }
+    SizeType capacity() const noexcept { return header_ ? header_->capacity : 0; }
+    bool empty() const noexcept { return size() == 0; }
+
+    T* data() noexcept { return buffer_; }
+    const T* data() const noexcept { return buffer_; }
+
+    Iterator begin() noexcept { return buffer_; }
+    ConstIterator begin() const noexcept { return buffer_; }
+    ConstIterator cbegin() const noexcept { return buffer_; }
+
+    Iterator end() noexcept { return buffer_ + size(); }
+    ConstIterator end() const noexcept { return buffer_ + size(); }
+    ConstIterator cend() const noexcept { return buffer_ + size(); }
+
+    T& operator[](SizeType index) noexcept { return buffer_[index]; }
+    const T& operator[](SizeType index) const noexcept { return buffer_[index]; }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return buffer_[size() - 1];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return buffer_[size() - 1];
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return buffer_[0];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return buffer_[0];
+    }
+
+    bool operator==(const MappedVector& other) const {
+        return size() == other.size() && CompareHelper::equal(data(), other.data(), size());
+    }
+
+    // Write-back of dirty pages; wait == false only schedules it (MS_ASYNC)
+    void sync(const bool wait = true) {
+        if constexpr (!read_only) {
+            if (map_ && ::msync(map_, mapped_bytes_, wait ? MS_SYNC : MS_ASYNC) != 0) {
+                fail("MappedVector: msync failed");
+            }
+        }
+    }
+
+    void reserve(SizeType new_capacity) requires(!read_only) {
+        if (new_capacity > capacity()) {
+            grow_file(new_capacity);
+        }
+    }
+
+    void push_back(const ValueType& value) requires(!read_only) {
+        if (size() == capacity()) {
+            // The mapping may move, and value may live in it
+            const ValueType copy(value);
+            grow_file(DoublingGrowth::next_capacity(capacity(), size() + 1, sizeof(ValueType)));
+            buffer_[header_->size++] = copy;
+            return;
+        }
+        buffer_[header_->size++] = value;
+    }
+
+    template <typename... Args>
+    void emplace_back(Args&&... args) requires(!read_only) {
+        push_back(ValueType(std::forward<Args>(args)...));
+    }
+
+    // Bulk append from any contiguous range, one memcpy into the mapping
+    template <std::ranges::contiguous_range R>
+        requires(!read_only && std::is_same_v<std::remove_cv_t<std::ranges::range_value_t<R>>, ValueType>)
+    void append_range(R&& r) {
+        const size_t count = static_cast<size_t>(std::ranges::size(r));
+        if (count == 0) return;
+        const ValueType* source = std::ranges::data(r);
+        if (count > capacity() - size()) {
+            // The mapping may move, and the source may live in it: find it again by its offset
+            const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(buffer_);
+            const std::uintptr_t at = reinterpret_cast<std::uintptr_t>(source);
+            const bool aliased = at >= first && at < first + size() * sizeof(ValueType);
+            const size_t offset = aliased ? static_cast<size_t>(source - buffer_) : 0;
+            grow_file(DoublingGrowth::next_capacity(capacity(), size() + count, sizeof(ValueType)));
+            if (aliased) {
+                source = buffer_ + offset;
+            }
+        }
+        std::memcpy(static_cast<void*>(buffer_ + size()), source, count * sizeof(ValueType));
+        header_->size += count;
+    }
+
+    void resize(SizeType new_size) requires(!read_only) {
+        reserve(new_size);
+        if (new_size > size()) {
+            std::uninitialized_value_construct(buffer_ + size(), buffer_ + new_size);
+        }
+        header_->size = new_size;
+    }
+
+    void pop_back() requires(!read_only) {
+        if (empty()) {
+            throw std::runtime_error("Cannot pop from empty vector");
+        }
+        --header_->size;
+    }
+
+    void clear() noexcept requires(!read_only) {
+        if (header_) header_->size = 0;
+    }
+};
@@ -0,0 +1,350 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <limits>
+#include <span>
+
+// Segment Layout
+// Segment k holds FirstSegment << k elements and starts at index FirstSegment * (2^k - 1), so
+// the segment of any index follows from the bit width of index + FirstSegment
+template <size_t FirstSegment>
+struct SegmentLayout {
+    static_assert(std::has_single_bit(FirstSegment), "SegmentLayout: first segment size must be a power of two");
+
+    static constexpr size_t first_shift = std::countr_zero(FirstSegment);
+    static constexpr size_t max_segments = std::numeric_limits<size_t>::digits - first_shift;
+
+    static constexpr size_t segment_size(const size_t segment) noexcept { return FirstSegment << segment; }
+
+    static constexpr size_t segment_start(const size_t segment) noexcept { return segment_size(segment) - FirstSegment; }
+
+    static constexpr size_t segment_of(const size_t index) noexcept {
+        return std::bit_width(index + FirstSegment) - 1 - first_shift;
+    }
+
+    static constexpr size_t offset_in(const size_t index, const size_t segment) noexcept {
+        return index - segment_start(segment);
+    }
+};
+
+// Segmented Vector
+// Elements live in segments of geometrically growing size (see SegmentLayout), so growing
+// allocates one new segment and never moves an element: pointers and references stay valid
+// until the element is erased, and push_back has no reallocation spikes.
+template <typename T, typename Allocator = DefaultAllocator<T>,
+          size_t FirstSegment = std::bit_floor(std::max<size_t>(1, 4096 / sizeof(T)))>
+class SegmentedVector {
+    using Traits = AllocatorHelper<T, Allocator>;
+    using Layout = SegmentLayout<FirstSegment>;
+
+public:
+    static constexpr size_t max_segments = Layout::max_segments;
+
+private:
+    T* segments_[max_segments];
+    size_t segment_count_;
+    size_t size_;
+    size_t capacity_;
+    [[no_unique_address]] Allocator allocator_;
+
+    static constexpr size_t segment_size(const size_t segment) noexcept { return Layout::segment_size(segment); }
+    static constexpr size_t segment_of(const size_t index) noexcept { return Layout::segment_of(index); }
+    static constexpr size_t offset_in(const size_t index, const size_t segment) noexcept {
+        return Layout::offset_in(index, segment);
+    }
+
+    void add_segment() {
+        if (segment_count_ == max_segments) {
+            throw std::bad_array_new_length();
+        }
+        Traits::allocate(segments_[segment_count_], allocator_, segment_size(segment_count_));
+        capacity_ += segment_size(segment_count_);
+        ++segment_count_;
+    }
+
+    void release_segments(const size_t keep) noexcept {
+        while (segment_count_ > keep) {
+            --segment_count_;
+            capacity_ -= segment_size(segment_count_);
+            Traits::deallocate(segments_[segment_count_], allocator_, segment_size(segment_count_));
+        }
+    }
+
+    void destroy_and_deallocate() noexcept {
+        clear();
+        release_segments(0);
+    }
+
+    // Take over other's segments; the caller has made sure our allocator can free them
+    void steal_from(SegmentedVector& other) noexcept {
+        std::copy(other.segments_, other.segments_ + other.segment_count_, segments_);
+        segment_count_ = other.segment_count_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.segment_count_ = 0;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+public:
+    using ValueType = T;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using AllocatorType = Allocator;
+
+    // Random-access iterator; stepping within a segment is a pointer increment
+    template <bool IsConst>
+    class SegmentIterator {
+    public:
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+        using value_type = T;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        SegmentIterator() noexcept : owner_(nullptr), index_(0), current_(nullptr), segment_end_(nullptr) {}
+        SegmentIterator(Owner* owner, const size_t index) noexcept : owner_(owner), index_(index) { locate(); }
+
+        operator SegmentIterator<true>() const noexcept { return SegmentIterator<true>(owner_, index_); }
+
+        reference operator*() const noexcept { return *current_; }
+        pointer operator->() const noexcept { return current_; }
+        reference operator[](const difference_type n) const noexcept { return (*owner_)[index_ + n]; }
+
+        SegmentIterator& operator++() noexcept {
+            ++index_;
+            if (++current_ == segment_end_) locate();
+            return *this;
+        }
+        SegmentIterator operator++(int) noexcept { SegmentIterator old = *this; ++*this; return old; }
+        SegmentIterator& operator--() noexcept { --index_; locate(); return *this; }
+        SegmentIterator operator--(int) noexcept { SegmentIterator old = *this; --*this; return old; }
+        SegmentIterator& operator+=(const difference_type n) noexcept { index_ += n; locate(); return *this; }
+        SegmentIterator& operator-=(const difference_type n) noexcept { index_ -= n; locate(); return *this; }
+
+        friend SegmentIterator operator+(SegmentIterator it, const difference_type n) noexcept { return it += n; }
+        friend SegmentIterator operator+(const difference_type n, SegmentIterator it) noexcept { return it += n; }
+        friend SegmentIterator operator-(SegmentIterator it, const difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const SegmentIterator& a, const SegmentIterator& b) noexcept {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const SegmentIterator& a, const SegmentIterator& b) noexcept { return a.index_ == b.index_; }
+        friend auto operator<=>(const SegmentIterator& a, const SegmentIterator& b) noexcept { return a.index_ <=> b.index_; }
+
+    private:
+        // Point at index_ and remember where its segment ends; past the last segment both are null
+        void locate() noexcept {
+            const size_t segment = segment_of(index_);
+            if (owner_ && segment < owner_->segment_count_) {
+                current_ = owner_->segments_[segment] + offset_in(index_, segment);
+                segment_end_ = owner_->segments_[segment] + segment_size(segment);
+            } else {
+                current_ = nullptr;
+                segment_end_ = nullptr;
+            }
+        }
+
+        Owner* owner_;
+        size_t index_;
+        pointer current_;
+        pointer segment_end_;
+    };
+
+    using Iterator = SegmentIterator<false>;
+    using ConstIterator = SegmentIterator<true>;
+
+    SegmentedVector() noexcept(std::is_nothrow_default_constructible<Allocator>::value)
+        : segment_count_(0), size_(0), capacity_(0), allocator_(Allocator()) {}
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept
+        : segment_count_(0), size_(0), capacity_(0), allocator_(alloc) {}
+
+    SegmentedVector(const SegmentedVector& other)
+        : segment_count_(0), size_(0), capacity_(0), allocator_(Traits::select_on_copy_construction(other.allocator_)) {
+        try {
+            reserve(other.size_);
+            for (const T& element : other) {
+                emplace_back(element);
+            }
+        } catch (...) {
+            destroy_and_deallocate();
+            throw;
+        }
+    }
+
+    // Segments change owner as a whole, so moving never touches the elements
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : segment_count_(0), size_(0), capacity_(0), allocator_(std::move(other.allocator_)) {
+        steal_from(other);
+    }
+
+    // Reuses the segments already allocated here
+    SegmentedVector& operator=(const SegmentedVector& other) {
+        if (this == &other) return *this;
+        if constexpr (Traits::propagate_on_copy_assignment) {
+            if (!Traits::equal(allocator_, other.allocator_)) {
+                destroy_and_deallocate();
+            }
+            allocator_ = other.allocator_;
+        }
+        clear();
+        reserve(other.size_);
+        for (const T& element : other) {
+            emplace_back(element);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept(Traits::propagate_on_move_assignment || Traits::is_always_equal) {
+        if (this == &other) return *this;
+        if (Traits::propagate_on_move_assignment || Traits::equal(allocator_, other.allocator_)) {
+            destroy_and_deallocate();
+            if constexpr (Traits::propagate_on_move_assignment) {
+                allocator_ = std::move(other.allocator_);
+            }
+            steal_from(other);
+        } else {
+            // Storage from other's allocator cannot be freed through ours: move element-wise
+            clear();
+            reserve(other.size_);
+            for (T& element : other) {
+                emplace_back(std::move(element));
+            }
+            other.destroy_and_deallocate();
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() { destroy_and_deallocate(); }
+
+    void swap(SegmentedVector& other) noexcept {
+        T* segments[max_segments];
+        std::copy(segments_, segments_ + segment_count_, segments);
+        std::copy(other.segments_, other.segments_ + other.segment_count_, segments_);
+        std::copy(segments, segments + segment_count_, other.segments_);
+        std::swap(segment_count_, other.segment_count_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        if constexpr (Traits::propagate_on_swap) {
+            std::swap(allocator_, other.allocator_);
+        }
+    }
+
+    SizeType size() const noexcept { return size_; }
+    SizeType capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    T& operator[](const SizeType index) noexcept {
+        const size_t segment = segment_of(index);
+        return segments_[segment][offset_in(index, segment)];
+    }
+
+    const T& operator[](const SizeType index) const noexcept {
+        const size_t segment = segment_of(index);
+        return segments_[segment][offset_in(index, segment)];
+    }
+
+    Iterator begin() noexcept { return Iterator(this, 0); }
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator cbegin() const noexcept { return ConstIterator(this, 0); }
+
+    Iterator end() noexcept { return Iterator(this, size_); }
+    ConstIterator end() const noexcept { return ConstIterator(this, size_); }
+    ConstIterator cend() const noexcept { return ConstIterator(this, size_); }
+
+    // The live part of each segment, for loops that want contiguous spans
+    SizeType segment_count() const noexcept { return size_ == 0 ? 0 : segment_of(size_ - 1) + 1; }
+
+    std::span<T> segment(const SizeType k) noexcept {
+        const size_t first = Layout::segment_start(k);
+        return {segments_[k], std::min(segment_size(k), size_ - first)};
+    }
+
+    std::span<const T> segment(const SizeType k) const noexcept {
+        const size_t first = Layout::segment_start(k);
+        return {segments_[k], std::min(segment_size(k), size_ - first)};
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            add_segment();
+        }
+        const size_t segment = segment_of(size_);
+        T* slot = segments_[segment] + offset_in(size_, segment);
+        Traits::construct(slot, allocator_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        if (size_ == 0) {
+            throw std::runtime_error("Cannot pop from empty vector");
+        }
+        --size_;
+        Traits::destroy(&(*this)[size_], allocator_);
+    }
+
+    T& back() {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return (*this)[size_ - 1];
+    }
+
+    const T& back() const {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return (*this)[size_ - 1];
+    }
+
+    T& front() {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return segments_[0][0];
+    }
+
+    const T& front() const {
+        if (size_ == 0) {
+            throw std::runtime_error("Vector is empty");
+        }
+        return segments_[0][0];
+    }
+
+    // Allocates the missing segments up front; existing elements stay where they are
+    void reserve(const SizeType new_capacity) {
+        while (capacity_ < new_capacity) {
+            add_segment();
+        }
+    }
+
+    // Return the segments that hold no elements
+    void shrink_to_fit() noexcept {
+        release_segments(segment_count());
+    }
+
+    void clear() noexcept {
+        for (size_t k = 0, count = segment_count(); k < count; ++k) {
+            for (T& element : segment(k)) {
+                Traits::destroy(&element, allocator_);
+            }
+        }
+        size_ = 0;
+    }
+
+    Allocator get_allocator() const {
+        return allocator_;
+    }
+
+    bool operator==(const SegmentedVector& other) const {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+};
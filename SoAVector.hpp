@@ -0,0 +1,363 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <span>
+#include <tuple>
+
+// Structure-of-Arrays Vector
+// Stores each field of a record in its own contiguous column, so a loop over one field streams
+// only that field through the cache. All columns live in one allocation, each starting on a
+// cache-line boundary:
+//
+//   SoAVector<float, float, int> particles;
+//   particles.emplace_back(1.0f, 2.0f, 7);
+//   for (float& x : particles.column<0>()) x *= 2;
+//   auto [x, y, id] = particles[0];
+template <typename... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector: at least one field is required");
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    // Rows are proxies: tuples of references into the columns
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+    using SizeType = size_t;
+    using DifferenceType = std::ptrdiff_t;
+
+    static constexpr size_t column_alignment = std::max({size_t(64), alignof(Fields)...});
+
+private:
+    template <typename F>
+    using FieldTraits = AllocatorHelper<F, DefaultAllocator<F>>;
+
+    static constexpr size_t row_bytes = (sizeof(Fields) + ...);
+
+    void* block_;
+    std::tuple<Fields*...> columns_;
+    size_t size_;
+    size_t capacity_;
+
+    static constexpr size_t align_up(const size_t bytes) noexcept {
+        return (bytes + column_alignment - 1) & ~(column_alignment - 1);
+    }
+
+    static size_t block_bytes(const size_t capacity) {
+        if (capacity > (static_cast<size_t>(-1) - sizeof...(Fields) * column_alignment) / row_bytes) {
+            throw std::bad_array_new_length();
+        }
+        return (align_up(capacity * sizeof(Fields)) + ...);
+    }
+
+    template <typename F>
+    static F* carve_column(unsigned char* base, size_t& offset, const size_t capacity) noexcept {
+        F* column = reinterpret_cast<F*>(base + offset);
+        offset += align_up(capacity * sizeof(F));
+        return column;
+    }
+
+    // Column pointers for a block holding `capacity` rows; braced initialization runs left to right
+    static std::tuple<Fields*...> carve(void* block, const size_t capacity) noexcept {
+        size_t offset = 0;
+        auto* base = static_cast<unsigned char*>(block);
+        return std::tuple<Fields*...>{carve_column<Fields>(base, offset, capacity)...};
+    }
+
+    static void* allocate_block(const size_t capacity) {
+        return ::operator new(block_bytes(capacity), std::align_val_t{column_alignment});
+    }
+
+    static void deallocate_block(void* block, const size_t capacity) noexcept {
+        if (block) {
+            ::operator delete(block, block_bytes(capacity), std::align_val_t{column_alignment});
+        }
+    }
+
+    template <size_t... I>
+    void relocate_columns(const std::tuple<Fields*...>& dest, std::index_sequence<I...>) {
+        (relocate_column<I>(std::get<I>(dest)), ...);
+    }
+
+    template <size_t I>
+    void relocate_column(FieldType<I>* dest) {
+        DefaultAllocator<FieldType<I>> allocator;
+        FieldTraits<FieldType<I>>::relocate(dest, std::get<I>(columns_), size_, allocator);
+    }
+
+    // Move rows into a fresh block of new_capacity rows; construct_new(columns) may build extra rows
+    // in the new block first, while the old rows (which its arguments may refer to) are still intact
+    template <typename ConstructNew>
+    void reallocate(const size_t new_capacity, ConstructNew&& construct_new) {
+        void* new_block = allocate_block(new_capacity);
+        const auto new_columns = carve(new_block, new_capacity);
+        try {
+            construct_new(new_columns);
+        } catch (...) {
+            deallocate_block(new_block, new_capacity);
+            throw;
+        }
+
+        relocate_columns(new_columns, std::index_sequence_for<Fields...>{});
+        deallocate_block(block_, capacity_);
+
+        block_ = new_block;
+        columns_ = new_columns;
+        capacity_ = new_capacity;
+    }
+
+    size_t grown_capacity(const size_t required) const noexcept {
+        return DoublingGrowth::next_capacity(capacity_, required, row_bytes);
+    }
+
+    // Construct row `index` of `columns` field by field, undoing the finished fields if one throws
+    template <typename... Args, size_t... I>
+    static void construct_row(const std::tuple<Fields*...>& columns, const size_t index, std::index_sequence<I...>,
+                              Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((::new (static_cast<void*>(std::get<I>(columns) + index)) FieldType<I>(std::forward<Args>(args)),
+              ++constructed),
+             ...);
+        } catch (...) {
+            (((I < constructed) ? std::get<I>(columns)[index].~FieldType<I>() : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... I>
+    void destroy_rows(const size_t first, const size_t last, std::index_sequence<I...>) noexcept {
+        (destroy_column_range<I>(first, last), ...);
+    }
+
+    template <size_t I>
+    void destroy_column_range(const size_t first, const size_t last) noexcept {
+        DefaultAllocator<FieldType<I>> allocator;
+        for (size_t i = first; i < last; ++i) {
+            FieldTraits<FieldType<I>>::destroy(std::get<I>(columns_) + i, allocator);
+        }
+    }
+
+    // Close the gap [first, last) in column I, leaving size_ - (last - first) live elements
+    template <size_t I>
+    void erase_column_range(const size_t first, const size_t last) {
+        using F = FieldType<I>;
+        F* column = std::get<I>(columns_);
+        DefaultAllocator<F> allocator;
+        if constexpr (is_trivially_relocatable_v<F>) {
+            for (size_t i = first; i < last; ++i) {
+                FieldTraits<F>::destroy(column + i, allocator);
+            }
+            FieldTraits<F>::relocate_overlapping(column + first, column + last, size_ - last, allocator);
+        } else {
+            std::move(column + last, column + size_, column + first);
+            for (size_t i = size_ - (last - first); i < size_; ++i) {
+                FieldTraits<F>::destroy(column + i, allocator);
+            }
+        }
+    }
+
+    template <size_t... I>
+    Reference row(const size_t index, std::index_sequence<I...>) noexcept {
+        return Reference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I>
+    ConstReference row(const size_t index, std::index_sequence<I...>) const noexcept {
+        return ConstReference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I>
+    void copy_rows_from(const SoAVector& other, std::index_sequence<I...>) {
+        for (; size_ < other.size_; ++size_) {
+            construct_row(columns_, size_, std::index_sequence_for<Fields...>{}, std::get<I>(other.columns_)[size_]...);
+        }
+    }
+
+public:
+    // Random-access iterator over rows; dereferencing yields a Reference or ConstReference proxy
+    template <bool IsConst>
+    class RowIterator {
+    public:
+        using Owner = std::conditional_t<IsConst, const SoAVector, SoAVector>;
+        using value_type = std::tuple<Fields...>;
+        using reference = std::conditional_t<IsConst, ConstReference, Reference>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        RowIterator() noexcept : owner_(nullptr), index_(0) {}
+        RowIterator(Owner* owner, const size_t index) noexcept : owner_(owner), index_(index) {}
+
+        // Mutable iterators convert to const ones
+        operator RowIterator<true>() const noexcept { return RowIterator<true>(owner_, index_); }
+
+        reference operator*() const noexcept { return (*owner_)[index_]; }
+        reference operator[](const difference_type n) const noexcept { return (*owner_)[index_ + n]; }
+
+        RowIterator& operator++() noexcept { ++index_; return *this; }
+        RowIterator operator++(int) noexcept { RowIterator old = *this; ++index_; return old; }
+        RowIterator& operator--() noexcept { --index_; return *this; }
+        RowIterator operator--(int) noexcept { RowIterator old = *this; --index_; return old; }
+        RowIterator& operator+=(const difference_type n) noexcept { index_ += n; return *this; }
+        RowIterator& operator-=(const difference_type n) noexcept { index_ -= n; return *this; }
+
+        friend RowIterator operator+(RowIterator it, const difference_type n) noexcept { return it += n; }
+        friend RowIterator operator+(const difference_type n, RowIterator it) noexcept { return it += n; }
+        friend RowIterator operator-(RowIterator it, const difference_type n) noexcept { return it -= n; }
+        friend difference_type operator-(const RowIterator& a, const RowIterator& b) noexcept {
+            return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+        }
+
+        friend bool operator==(const RowIterator& a, const RowIterator& b) noexcept { return a.index_ == b.index_; }
+        friend auto operator<=>(const RowIterator& a, const RowIterator& b) noexcept { return a.index_ <=> b.index_; }
+
+        size_t index() const noexcept { return index_; }
+
+    private:
+        Owner* owner_;
+        size_t index_;
+    };
+
+    using Iterator = RowIterator<false>;
+    using ConstIterator = RowIterator<true>;
+
+    SoAVector() noexcept : block_(nullptr), columns_(), size_(0), capacity_(0) {}
+
+    SoAVector(const SoAVector& other) : SoAVector() {
+        reserve(other.size_);
+        try {
+            copy_rows_from(other, std::index_sequence_for<Fields...>{});
+        } catch (...) {
+            destroy_and_deallocate();
+            throw;
+        }
+    }
+
+    SoAVector(SoAVector&& other) noexcept
+        : block_(other.block_), columns_(other.columns_), size_(other.size_), capacity_(other.capacity_) {
+        other.block_ = nullptr;
+        other.columns_ = {};
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    SoAVector& operator=(const SoAVector& other) {
+        if (this != &other) {
+            SoAVector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& other) noexcept {
+        if (this != &other) {
+            destroy_and_deallocate();
+            swap(other);
+        }
+        return *this;
+    }
+
+    ~SoAVector() { destroy_and_deallocate(); }
+
+    void swap(SoAVector& other) noexcept {
+        std::swap(block_, other.block_);
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    SizeType size() const noexcept { return size_; }
+    SizeType capacity() const noexcept { return capacity_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    // Column I as a contiguous span of size() elements, aligned to column_alignment
+    template <size_t I>
+    std::span<FieldType<I>> column() noexcept { return {std::get<I>(columns_), size_}; }
+
+    template <size_t I>
+    std::span<const FieldType<I>> column() const noexcept { return {std::get<I>(columns_), size_}; }
+
+    template <size_t I>
+    FieldType<I>& get(const SizeType index) noexcept { return std::get<I>(columns_)[index]; }
+
+    template <size_t I>
+    const FieldType<I>& get(const SizeType index) const noexcept { return std::get<I>(columns_)[index]; }
+
+    Reference operator[](const SizeType index) noexcept { return row(index, std::index_sequence_for<Fields...>{}); }
+    ConstReference operator[](const SizeType index) const noexcept { return row(index, std::index_sequence_for<Fields...>{}); }
+
+    Iterator begin() noexcept { return Iterator(this, 0); }
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+    Iterator end() noexcept { return Iterator(this, size_); }
+    ConstIterator end() const noexcept { return ConstIterator(this, size_); }
+
+    void reserve(const SizeType new_capacity) {
+        if (new_capacity > capacity_) {
+            reallocate(new_capacity, [](const std::tuple<Fields*...>&) {});
+        }
+    }
+
+    // One value per field, in field order
+    template <typename... Args>
+        requires(sizeof...(Args) == sizeof...(Fields))
+    Reference emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            reallocate(grown_capacity(size_ + 1), [&](const std::tuple<Fields*...>& columns) {
+                construct_row(columns, size_, std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+            });
+        } else {
+            construct_row(columns_, size_, std::index_sequence_for<Fields...>{}, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void push_back(const Fields&... values) { emplace_back(values...); }
+
+    void pop_back() {
+        if (size_ == 0) {
+            throw std::runtime_error("Cannot pop from empty vector");
+        }
+        destroy_rows(size_ - 1, size_, std::index_sequence_for<Fields...>{});
+        --size_;
+    }
+
+    // Remove rows [first, last), shifting the following rows down in every column
+    Iterator erase(ConstIterator first, ConstIterator last) {
+        const size_t begin_index = first.index();
+        const size_t end_index = last.index();
+        if (begin_index > end_index || end_index > size_) {
+            throw std::out_of_range("Invalid erase range");
+        }
+        if (begin_index == end_index) return Iterator(this, begin_index);
+
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            (erase_column_range<I>(begin_index, end_index), ...);
+        }(std::index_sequence_for<Fields...>{});
+        size_ -= end_index - begin_index;
+        return Iterator(this, begin_index);
+    }
+
+    Iterator erase(ConstIterator pos) {
+        if (pos.index() >= size_) {
+            throw std::out_of_range("Iterator out of range");
+        }
+        return erase(pos, pos + 1);
+    }
+
+    void clear() noexcept {
+        destroy_rows(0, size_, std::index_sequence_for<Fields...>{});
+        size_ = 0;
+    }
+
+private:
+    void destroy_and_deallocate() noexcept {
+        clear();
+        deallocate_block(block_, capacity_);
+        block_ = nullptr;
+        columns_ = {};
+        capacity_ = 0;
+    }
+};
@@ -0,0 +1,2596 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <exception>
+#include <source_location>
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(VECTOR_ENABLE_STATS)
+#include "VectorStats.hpp"
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define VECTOR_HAS_AVX2_KERNEL 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define VECTOR_HAS_NEON_KERNEL 1
+#endif
+
+// Basic Allocator
+template <typename T>
+class DefaultAllocator {
+public:
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using AllocatorType = DefaultAllocator<T>;
+    using IsAlwaysEqual = std::true_type;
+
+    template <typename U>
+    struct Rebind {
+        using Other = DefaultAllocator<U>;
+    };
+
+    constexpr DefaultAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr DefaultAllocator(const DefaultAllocator<U>&) noexcept {}
+
+    // Constant evaluation can only allocate through std::allocator
+    constexpr T* allocate(const size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>().allocate(n);
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+        } else {
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+    }
+
+    constexpr void deallocate(T* p, const size_t n) noexcept {
+        if (std::is_constant_evaluated()) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, n * sizeof(T), std::align_val_t{alignof(T)});
+        } else {
+            ::operator delete(p, n * sizeof(T));
+        }
+    }
+
+    template <typename U>
+    constexpr bool operator==(const DefaultAllocator<U>&) const noexcept { return true; }
+};
+
+// Aligned Allocator
+// Buffers start on an Alignment boundary (e.g. a cache line, or an AVX-512 register) and are
+// padded to a whole number of Alignment-sized blocks. A SIMD kernel may therefore load full
+// blocks up to the block holding the last element without leaving the allocation; good_size()
+// hands the padding to the container as extra capacity.
+template <typename T, size_t Alignment = 64>
+class AlignedAllocator {
+    static_assert(std::has_single_bit(Alignment), "AlignedAllocator: alignment must be a power of two");
+
+public:
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using AllocatorType = AlignedAllocator<T, Alignment>;
+    using IsAlwaysEqual = std::true_type;
+
+    static constexpr size_t alignment = std::max(Alignment, alignof(T));
+
+    template <typename U>
+    struct Rebind {
+        using Other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(const size_t n) {
+        if (n > (static_cast<size_t>(-1) - alignment) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(padded_bytes(n), std::align_val_t{alignment}));
+    }
+
+    void deallocate(T* p, const size_t n) noexcept {
+        ::operator delete(p, padded_bytes(n), std::align_val_t{alignment});
+    }
+
+    size_t good_size(const size_t n) const noexcept {
+        return padded_bytes(n) / sizeof(T);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+private:
+    static constexpr size_t padded_bytes(const size_t n) noexcept {
+        return (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+    }
+};
+
+// Relocation Traits
+// A type is trivially relocatable when moving it to a new address and destroying
+// the source is equivalent to copying its bytes. Specialize for types that qualify
+// without being trivially copyable.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Rebinding an allocator to another element type:
+// Allocator::Rebind<U>::Other, then std-style rebind<U>::other, then Alloc<T, Args...> -> Alloc<U, Args...>
+template <typename Allocator, typename U>
+struct RebindAllocator;
+
+template <template <typename, typename...> class Alloc, typename T, typename... Args, typename U>
+struct RebindAllocator<Alloc<T, Args...>, U> {
+    using Type = Alloc<U, Args...>;
+};
+
+template <typename Allocator, typename U>
+    requires requires { typename Allocator::template Rebind<U>::Other; }
+struct RebindAllocator<Allocator, U> {
+    using Type = typename Allocator::template Rebind<U>::Other;
+};
+
+template <typename Allocator, typename U>
+    requires (!requires { typename Allocator::template Rebind<U>::Other; }) &&
+             requires { typename Allocator::template rebind<U>::other; }
+struct RebindAllocator<Allocator, U> {
+    using Type = typename Allocator::template rebind<U>::other;
+};
+
+// Streaming Transfers
+// Copies and fills much larger than the last-level cache get nothing from it: they evict the
+// working set of every other thread on the socket, and each destination line is read before it
+// is overwritten. copy() and fill() switch to non-temporal stores, which go straight to memory,
+// at or above their own thresholds. The store width (AVX or SSE2) is picked at run time; other
+// targets always use memcpy.
+//
+// Fills stream from the size of the last-level cache up, or from VECTOR_STREAMING_FILL_THRESHOLD
+// bytes. Copies stream only from VECTOR_STREAMING_COPY_THRESHOLD bytes and are off by default:
+// BM_StreamingCopy shows no steady win over memcpy. set_fill_threshold() and
+// set_copy_threshold() change the thresholds for the whole process; SIZE_MAX turns streaming off.
+class StreamHelper {
+public:
+    static size_t fill_threshold() noexcept { return fill_storage().load(std::memory_order_relaxed); }
+    static size_t copy_threshold() noexcept { return copy_storage().load(std::memory_order_relaxed); }
+
+    static void set_fill_threshold(const size_t bytes) noexcept {
+        fill_storage().store(bytes, std::memory_order_relaxed);
+    }
+
+    static void set_copy_threshold(const size_t bytes) noexcept {
+        copy_storage().store(bytes, std::memory_order_relaxed);
+    }
+
+    static bool streams_fill(const size_t bytes) noexcept {
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        return bytes >= fill_threshold();
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static bool streams_copy(const size_t bytes) noexcept {
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        return bytes >= copy_threshold();
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    // memcpy, with streaming stores for blocks of at least copy_threshold() bytes
+    static void copy(void* dest, const void* src, const size_t bytes) noexcept {
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        if (streams_copy(bytes)) {
+            if (has_avx()) {
+                stream_copy_avx(static_cast<unsigned char*>(dest), static_cast<const unsigned char*>(src), bytes);
+            } else {
+                stream_copy_sse2(static_cast<unsigned char*>(dest), static_cast<const unsigned char*>(src), bytes);
+            }
+            return;
+        }
+#endif
+        std::memcpy(dest, src, bytes);
+    }
+
+    // Types that tile a 32-byte block, so one block pattern repeats across the whole fill
+    template <typename T>
+    static constexpr bool can_fill = std::is_trivially_copyable_v<T> && 32 % sizeof(T) == 0;
+
+    // Write n copies of value into dest with streaming stores; intended for n * sizeof(T) at or
+    // above fill_threshold()
+    template <typename T>
+        requires can_fill<T>
+    static void fill(T* dest, const size_t n, const T& value) noexcept {
+        size_t i = 0;
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        // Whole elements up to a 32-byte boundary; reachable only at a multiple of sizeof(T)
+        if (reinterpret_cast<uintptr_t>(dest) % sizeof(T) == 0) {
+            alignas(32) unsigned char pattern[32];
+            for (size_t k = 0; k < sizeof(pattern); k += sizeof(T)) {
+                std::memcpy(pattern + k, &value, sizeof(T));
+            }
+            const size_t head = std::min(n, (0 - reinterpret_cast<uintptr_t>(dest)) % 32 / sizeof(T));
+            for (; i < head; ++i) {
+                std::memcpy(static_cast<void*>(dest + i), &value, sizeof(T));
+            }
+            const size_t blocks = (n - i) * sizeof(T) / 32;
+            if (has_avx()) {
+                stream_fill_avx(reinterpret_cast<unsigned char*>(dest + i), pattern, blocks);
+            } else {
+                stream_fill_sse2(reinterpret_cast<unsigned char*>(dest + i), pattern, blocks);
+            }
+            i += blocks * 32 / sizeof(T);
+        }
+#endif
+        for (; i < n; ++i) {
+            std::memcpy(static_cast<void*>(dest + i), &value, sizeof(T));
+        }
+    }
+
+private:
+    static std::atomic<size_t>& fill_storage() noexcept {
+        static std::atomic<size_t> bytes(default_fill_threshold());
+        return bytes;
+    }
+
+    static std::atomic<size_t>& copy_storage() noexcept {
+#if defined(VECTOR_STREAMING_COPY_THRESHOLD)
+        static std::atomic<size_t> bytes(VECTOR_STREAMING_COPY_THRESHOLD);
+#else
+        static std::atomic<size_t> bytes(SIZE_MAX);
+#endif
+        return bytes;
+    }
+
+    static size_t default_fill_threshold() noexcept {
+#if defined(VECTOR_STREAMING_FILL_THRESHOLD)
+        return VECTOR_STREAMING_FILL_THRESHOLD;
+#else
+#if defined(__linux__) && defined(_SC_LEVEL3_CACHE_SIZE)
+        if (const long cache = sysconf(_SC_LEVEL3_CACHE_SIZE); cache > 0) {
+            return static_cast<size_t>(cache);
+        }
+#endif
+        return size_t(32) << 20;
+#endif
+    }
+
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+    static bool has_avx() noexcept {
+#if defined(__AVX__)
+        return true;
+#else
+        static const bool supported = __builtin_cpu_supports("avx");
+        return supported;
+#endif
+    }
+
+    // Unaligned head and tail go through memcpy; the body is aligned streaming stores. The fence
+    // orders the weakly ordered streaming stores before whatever the caller publishes next.
+    __attribute__((target("avx"))) static void stream_copy_avx(unsigned char* d, const unsigned char* s,
+                                                               size_t bytes) noexcept {
+        const size_t head = std::min(bytes, static_cast<size_t>((0 - reinterpret_cast<uintptr_t>(d)) % 32));
+        std::memcpy(d, s, head);
+        d += head;
+        s += head;
+        bytes -= head;
+        for (; bytes >= 128; bytes -= 128, d += 128, s += 128) {
+            const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+            const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+            const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+            const __m256i e = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d), a);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), b);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), c);
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), e);
+        }
+        _mm_sfence();
+        std::memcpy(d, s, bytes);
+    }
+
+    static void stream_copy_sse2(unsigned char* d, const unsigned char* s, size_t bytes) noexcept {
+        const size_t head = std::min(bytes, static_cast<size_t>((0 - reinterpret_cast<uintptr_t>(d)) % 16));
+        std::memcpy(d, s, head);
+        d += head;
+        s += head;
+        bytes -= head;
+        for (; bytes >= 64; bytes -= 64, d += 64, s += 64) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+            const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        }
+        _mm_sfence();
+        std::memcpy(d, s, bytes);
+    }
+
+    // blocks 32-byte blocks of pattern at 32-byte aligned d
+    __attribute__((target("avx"))) static void stream_fill_avx(unsigned char* d, const unsigned char* pattern,
+                                                               const size_t blocks) noexcept {
+        const __m256i p = _mm256_load_si256(reinterpret_cast<const __m256i*>(pattern));
+        for (size_t i = 0; i < blocks; ++i) {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d + i * 32), p);
+        }
+        _mm_sfence();
+    }
+
+    static void stream_fill_sse2(unsigned char* d, const unsigned char* pattern, const size_t blocks) noexcept {
+        const __m128i lo = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+        const __m128i hi = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern + 16));
+        for (size_t i = 0; i < blocks; ++i) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i * 32), lo);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d + i * 32 + 16), hi);
+        }
+        _mm_sfence();
+    }
+#endif
+};
+
+// Basic AllocatorTraits
+// Works with any allocator providing allocate(n) and sized deallocate(p, n). Optional members
+// (construct, destroy, propagation flags, IsAlwaysEqual, select_on_copy_construction) are
+// detected and fall back to the same defaults std::allocator_traits uses; the standard
+// snake_case spellings are accepted as well, so std and pmr allocators plug in directly.
+template <typename T, typename Allocator = DefaultAllocator<T>>
+class AllocatorHelper {
+    static constexpr bool detect_copy_propagation() {
+        if constexpr (requires { typename Allocator::PropagateOnCopyAssignment; })
+            return Allocator::PropagateOnCopyAssignment::value;
+        else if constexpr (requires { typename Allocator::propagate_on_container_copy_assignment; })
+            return Allocator::propagate_on_container_copy_assignment::value;
+        else
+            return false;
+    }
+
+    static constexpr bool detect_move_propagation() {
+        if constexpr (requires { typename Allocator::PropagateOnMoveAssignment; })
+            return Allocator::PropagateOnMoveAssignment::value;
+        else if constexpr (requires { typename Allocator::propagate_on_container_move_assignment; })
+            return Allocator::propagate_on_container_move_assignment::value;
+        else
+            return false;
+    }
+
+    static constexpr bool detect_swap_propagation() {
+        if constexpr (requires { typename Allocator::PropagateOnSwap; })
+            return Allocator::PropagateOnSwap::value;
+        else if constexpr (requires { typename Allocator::propagate_on_container_swap; })
+            return Allocator::propagate_on_container_swap::value;
+        else
+            return false;
+    }
+
+    static constexpr bool detect_always_equal() {
+        if constexpr (requires { typename Allocator::IsAlwaysEqual; })
+            return Allocator::IsAlwaysEqual::value;
+        else if constexpr (requires { typename Allocator::is_always_equal; })
+            return Allocator::is_always_equal::value;
+        else
+            return std::is_empty_v<Allocator>;
+    }
+
+    static constexpr size_t detect_alignment() {
+        if constexpr (requires { { Allocator::alignment } -> std::convertible_to<size_t>; })
+            return std::max<size_t>(Allocator::alignment, alignof(T));
+        else
+            return alignof(T);
+    }
+
+public:
+    using AllocatorType = Allocator;
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+
+    template <typename U>
+    using Rebind = typename RebindAllocator<Allocator, U>::Type;
+
+    static constexpr bool propagate_on_copy_assignment = detect_copy_propagation();
+    static constexpr bool propagate_on_move_assignment = detect_move_propagation();
+    static constexpr bool propagate_on_swap = detect_swap_propagation();
+    static constexpr bool is_always_equal = detect_always_equal();
+    // Alignment of every block allocate() returns
+    static constexpr size_t alignment = detect_alignment();
+
+    // Everything below is constexpr: with an allocator that supports constant evaluation (like
+    // DefaultAllocator), a Vector can be built and consumed at compile time
+    static constexpr void allocate(T*& p, Allocator& a, const size_t n) {
+        p = a.allocate(n);
+    }
+    template <typename... Args>
+    static constexpr void construct(T* p, Allocator& a, Args&&... args) {
+        if constexpr (requires { a.construct(p, std::forward<Args>(args)...); })
+            a.construct(p, std::forward<Args>(args)...);
+        else
+            std::construct_at(p, std::forward<Args>(args)...);
+    }
+    // Default-initialization leaves trivial types untouched, so it bypasses the allocator's construct.
+    // Constant evaluation cannot leave them indeterminate and value-initializes instead.
+    static constexpr void construct_default(T* p, Allocator&) {
+        if (std::is_constant_evaluated())
+            std::construct_at(p);
+        else
+            ::new (static_cast<void*>(p)) T;
+    }
+    static constexpr void destroy(T* p, Allocator& a) {
+        if constexpr (requires { a.destroy(p); })
+            a.destroy(p);
+        else
+            std::destroy_at(p);
+    }
+    static constexpr void deallocate(T* p, Allocator& a, const size_t n) {
+        a.deallocate(p, n);
+    }
+
+    // Number of elements the allocator really hands out for a request of n (its size class)
+    static constexpr size_t good_size(const Allocator& a, const size_t n) {
+        if constexpr (requires { { a.good_size(n) } -> std::convertible_to<size_t>; })
+            return std::max(static_cast<size_t>(a.good_size(n)), n);
+        else
+            return n;
+    }
+
+    // Try to grow the allocation at p from old_n to new_n elements without moving it
+    static constexpr bool expand(T* p, Allocator& a, const size_t old_n, const size_t new_n) {
+        if constexpr (requires { { a.expand(p, old_n, new_n) } -> std::convertible_to<bool>; })
+            return a.expand(p, old_n, new_n);
+        else
+            return false;
+    }
+
+    // True when the allocator can move a block of trivially relocatable elements by itself
+    static constexpr bool can_reallocate =
+        is_trivially_relocatable_v<T> && requires(Allocator& a, T* p, size_t n) { { a.reallocate(p, n, n) } -> std::convertible_to<T*>; };
+
+    // Resize the block at p from old_n to new_n elements, carrying the elements along (e.g. by
+    // remapping pages). Returns the new block, or nullptr if the caller has to copy.
+    static constexpr T* reallocate(T* p, Allocator& a, const size_t old_n, const size_t new_n) {
+        if constexpr (can_reallocate)
+            return a.reallocate(p, old_n, new_n);
+        else
+            return nullptr;
+    }
+
+    static constexpr Allocator select_on_copy_construction(const Allocator& a) {
+        if constexpr (requires { a.select_on_copy_construction(); })
+            return a.select_on_copy_construction();
+        else if constexpr (requires { a.select_on_container_copy_construction(); })
+            return a.select_on_container_copy_construction();
+        else
+            return a;
+    }
+
+    // True when storage obtained from one allocator may be released through the other
+    static constexpr bool equal(const Allocator& a, const Allocator& b) {
+        if constexpr (is_always_equal) return true;
+        else return a == b;
+    }
+
+    // Move n elements from src into uninitialized, non-overlapping dest and end their lifetime at src.
+    // If T's move may throw, every element is copied (or moved) before any source is destroyed, and
+    // a throw destroys the copies and leaves src untouched.
+    static constexpr void relocate(T* dest, T* src, const size_t n, Allocator& a) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n > 0)
+                    StreamHelper::copy(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+                return;
+            }
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T>) {
+            for (size_t i = 0; i < n; ++i) {
+                construct(dest + i, a, std::move(src[i]));
+                destroy(src + i, a);
+            }
+        } else {
+            size_t i = 0;
+            try {
+                for (; i < n; ++i) {
+                    construct(dest + i, a, std::move_if_noexcept(src[i]));
+                }
+            } catch (...) {
+                while (i > 0) {
+                    destroy(dest + --i, a);
+                }
+                throw;
+            }
+            for (i = 0; i < n; ++i) {
+                destroy(src + i, a);
+            }
+        }
+    }
+
+    // Same as relocate, but dest and src may overlap (shifting within one buffer)
+    static constexpr void relocate_overlapping(T* dest, T* src, const size_t n, Allocator& a) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n > 0)
+                    std::memmove(static_cast<void*>(dest), static_cast<const void*>(src), n * sizeof(T));
+                return;
+            }
+        }
+        if (dest < src) {
+            for (size_t i = 0; i < n; ++i) {
+                construct(dest + i, a, std::move(src[i]));
+                destroy(src + i, a);
+            }
+        } else {
+            for (size_t i = n; i > 0; --i) {
+                construct(dest + i - 1, a, std::move(src[i - 1]));
+                destroy(src + i - 1, a);
+            }
+        }
+    }
+};
+
+// Arena Allocator
+// Monotonic bump-pointer arena. Allocations are carved from chained chunks and released all at
+// once by reset() or destruction; only the most recent allocation can be freed or grown in place.
+// Not thread-safe.
+class Arena {
+public:
+    static constexpr size_t max_chunk_size = 16 * 1024 * 1024;
+
+    explicit Arena(const size_t chunk_size = 64 * 1024) noexcept
+        : head_(nullptr), cursor_(nullptr), limit_(nullptr), last_(nullptr), next_chunk_size_(chunk_size) {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        release_chunks(head_);
+    }
+
+    void* allocate(const size_t bytes, const size_t alignment) {
+        char* p = align_up(cursor_, alignment);
+        if (!head_ || p > limit_ || bytes > static_cast<size_t>(limit_ - p)) {
+            add_chunk(bytes + alignment);
+            p = align_up(cursor_, alignment);
+        }
+        cursor_ = p + bytes;
+        last_ = p;
+        return p;
+    }
+
+    // Memory is reclaimed by reset(); only the newest allocation is rolled back immediately
+    void deallocate(void* p, const size_t bytes) noexcept {
+        if (p == last_ && static_cast<char*>(p) + bytes == cursor_) {
+            cursor_ = static_cast<char*>(p);
+            last_ = nullptr;
+        }
+    }
+
+    // Grow the newest allocation in place if the current chunk has room
+    bool expand(void* p, const size_t old_bytes, const size_t new_bytes) noexcept {
+        char* start = static_cast<char*>(p);
+        if (p != last_ || start + old_bytes != cursor_ || new_bytes > static_cast<size_t>(limit_ - start)) {
+            return false;
+        }
+        cursor_ = start + new_bytes;
+        return true;
+    }
+
+    // Rewind to the newest (largest) chunk and free the others. Everything allocated from the
+    // arena so far must already be dead.
+    void reset() noexcept {
+        if (!head_) return;
+        release_chunks(head_->next);
+        head_->next = nullptr;
+        cursor_ = head_->data();
+        limit_ = cursor_ + head_->size;
+        last_ = nullptr;
+    }
+
+private:
+    struct alignas(std::max_align_t) Chunk {
+        Chunk* next;
+        size_t size;
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    static char* align_up(char* p, const size_t alignment) noexcept {
+        const auto value = reinterpret_cast<std::uintptr_t>(p);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1));
+    }
+
+    static void release_chunks(Chunk* chunk) noexcept {
+        while (chunk) {
+            Chunk* next = chunk->next;
+            ::operator delete(chunk, sizeof(Chunk) + chunk->size);
+            chunk = next;
+        }
+    }
+
+    void add_chunk(const size_t min_bytes) {
+        const size_t size = std::max(next_chunk_size_, min_bytes);
+        Chunk* chunk = ::new (::operator new(sizeof(Chunk) + size)) Chunk{head_, size};
+        head_ = chunk;
+        cursor_ = chunk->data();
+        limit_ = cursor_ + size;
+        last_ = nullptr;
+        next_chunk_size_ = std::max(next_chunk_size_, std::min(next_chunk_size_ * 2, max_chunk_size));
+    }
+
+    Chunk* head_;
+    char* cursor_;
+    char* limit_;
+    void* last_;
+    size_t next_chunk_size_;
+};
+
+template <typename T>
+class ArenaAllocator {
+public:
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using AllocatorType = ArenaAllocator<T>;
+
+    template <typename U>
+    struct Rebind {
+        using Other = ArenaAllocator<U>;
+    };
+
+    explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena()) {}
+
+    T* allocate(const size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, const size_t n) noexcept {
+        arena_->deallocate(p, n * sizeof(T));
+    }
+
+    bool expand(T* p, const size_t old_n, const size_t new_n) noexcept {
+        if (new_n > static_cast<size_t>(-1) / sizeof(T)) return false;
+        return arena_->expand(p, old_n * sizeof(T), new_n * sizeof(T));
+    }
+
+    Arena* arena() const noexcept { return arena_; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena_ == other.arena(); }
+
+private:
+    Arena* arena_;
+};
+
+// Pool Allocator
+// Power-of-two size classes with intrusive free lists, refilled from large slabs. Freed blocks
+// are recycled for later requests of the same class; requests above max_block_size or with
+// extended alignment go straight to ::operator new. Not thread-safe.
+class Pool {
+public:
+    static constexpr size_t min_block_size = 16;
+    static constexpr size_t max_block_size = 64 * 1024;
+
+    explicit Pool(const size_t slab_size = 256 * 1024) noexcept
+        : free_lists_{}, slabs_(nullptr), cursor_(nullptr), limit_(nullptr), slab_size_(slab_size) {
+    }
+
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    ~Pool() {
+        while (slabs_) {
+            Slab* next = slabs_->next;
+            ::operator delete(slabs_, sizeof(Slab) + slabs_->size);
+            slabs_ = next;
+        }
+    }
+
+    void* allocate(const size_t bytes, const size_t alignment) {
+        if (alignment > alignof(std::max_align_t)) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+        if (bytes > max_block_size) {
+            return ::operator new(bytes);
+        }
+        const size_t index = class_index(bytes);
+        if (FreeBlock* block = free_lists_[index]) {
+            free_lists_[index] = block->next;
+            return block;
+        }
+        return carve(class_size(index));
+    }
+
+    void deallocate(void* p, const size_t bytes, const size_t alignment) noexcept {
+        if (alignment > alignof(std::max_align_t)) {
+            ::operator delete(p, bytes, std::align_val_t(alignment));
+            return;
+        }
+        if (bytes > max_block_size) {
+            ::operator delete(p, bytes);
+            return;
+        }
+        const size_t index = class_index(bytes);
+        free_lists_[index] = ::new (p) FreeBlock{free_lists_[index]};
+    }
+
+    // Number of bytes actually reserved for a request of `bytes`
+    static size_t good_size(const size_t bytes) noexcept {
+        return (bytes > max_block_size) ? bytes : class_size(class_index(bytes));
+    }
+
+private:
+    static constexpr size_t class_count = std::countr_zero(max_block_size / min_block_size) + 1;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct alignas(std::max_align_t) Slab {
+        Slab* next;
+        size_t size;
+    };
+
+    static size_t class_index(const size_t bytes) noexcept {
+        return (bytes <= min_block_size) ? 0 : std::bit_width(bytes - 1) - std::countr_zero(min_block_size);
+    }
+
+    static size_t class_size(const size_t index) noexcept {
+        return min_block_size << index;
+    }
+
+    void* carve(const size_t block_size) {
+        if (static_cast<size_t>(limit_ - cursor_) < block_size) {
+            const size_t size = std::max(slab_size_, block_size);
+            Slab* slab = ::new (::operator new(sizeof(Slab) + size)) Slab{slabs_, size};
+            slabs_ = slab;
+            cursor_ = reinterpret_cast<char*>(slab + 1);
+            limit_ = cursor_ + size;
+        }
+        void* block = cursor_;
+        cursor_ += block_size;
+        return block;
+    }
+
+    FreeBlock* free_lists_[class_count];
+    Slab* slabs_;
+    char* cursor_;
+    char* limit_;
+    size_t slab_size_;
+};
+
+template <typename T>
+class PoolAllocator {
+public:
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using AllocatorType = PoolAllocator<T>;
+
+    template <typename U>
+    struct Rebind {
+        using Other = PoolAllocator<U>;
+    };
+
+    explicit PoolAllocator(Pool& pool) noexcept : pool_(&pool) {}
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(const size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(pool_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, const size_t n) noexcept {
+        pool_->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    // Elements that fit in the size class serving a request for n
+    size_t good_size(const size_t n) const noexcept {
+        return Pool::good_size(n * sizeof(T)) / sizeof(T);
+    }
+
+    Pool* pool() const noexcept { return pool_; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept { return pool_ == other.pool(); }
+
+private:
+    Pool* pool_;
+};
+
+#if defined(__linux__)
+// Mmap Allocator
+// Gives every buffer its own anonymous mapping, for vectors of hundreds of MB and more. Buffers
+// of 2 MiB and up are rounded to whole huge pages and marked MADV_HUGEPAGE; ExplicitHugePages
+// asks for MAP_HUGETLB pages first and falls back to transparent ones when none are reserved.
+// expand() and reallocate() use mremap, so a trivially relocatable vector grows without copying
+// and shrinks by unmapping the tail pages.
+template <typename T, bool ExplicitHugePages = false>
+class MmapAllocator {
+public:
+    using ValueType = T;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+    using AllocatorType = MmapAllocator<T, ExplicitHugePages>;
+    using IsAlwaysEqual = std::true_type;
+
+    static constexpr size_t page_size = 4096;
+    static constexpr size_t huge_page_size = size_t(2) << 20;
+    static constexpr size_t alignment = page_size;
+
+    static_assert(alignof(T) <= page_size, "MmapAllocator: mappings are only page aligned");
+
+    template <typename U>
+    struct Rebind {
+        using Other = MmapAllocator<U, ExplicitHugePages>;
+    };
+
+    MmapAllocator() noexcept = default;
+
+    template <typename U>
+    MmapAllocator(const MmapAllocator<U, ExplicitHugePages>&) noexcept {}
+
+    T* allocate(const size_t n) {
+        if (n > (static_cast<size_t>(-1) - huge_page_size) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        const size_t bytes = mapping_bytes(n);
+        void* p = MAP_FAILED;
+        if constexpr (ExplicitHugePages) {
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (p == MAP_FAILED) {
+            p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            advise_huge_pages(p, bytes);
+        }
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, const size_t n) noexcept {
+        ::munmap(p, mapping_bytes(n));
+    }
+
+    // Whole pages are mapped anyway, so hand them to the container as capacity
+    size_t good_size(const size_t n) const noexcept {
+        return mapping_bytes(n) / sizeof(T);
+    }
+
+    bool expand(T* p, const size_t old_n, const size_t new_n) noexcept {
+        const size_t old_bytes = mapping_bytes(old_n);
+        const size_t new_bytes = mapping_bytes(new_n);
+        if (new_bytes <= old_bytes) return true;
+        if (::mremap(p, old_bytes, new_bytes, 0) == MAP_FAILED) return false;
+        advise_huge_pages(p, new_bytes);
+        return true;
+    }
+
+    T* reallocate(T* p, const size_t old_n, const size_t new_n) noexcept {
+        const size_t old_bytes = mapping_bytes(old_n);
+        const size_t new_bytes = mapping_bytes(new_n);
+        if (new_bytes == old_bytes) return p;
+        void* moved = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+        if (moved == MAP_FAILED) return nullptr;
+        advise_huge_pages(moved, new_bytes);
+        return static_cast<T*>(moved);
+    }
+
+    template <typename U>
+    bool operator==(const MmapAllocator<U, ExplicitHugePages>&) const noexcept { return true; }
+
+private:
+    // Huge-page mappings must stay huge-page sized, also when they shrink
+    static constexpr size_t mapping_bytes(const size_t n) noexcept {
+        const size_t bytes = std::max<size_t>(n * sizeof(T), 1);
+        const size_t granularity = (ExplicitHugePages || bytes >= huge_page_size) ? huge_page_size : page_size;
+        return (bytes + granularity - 1) & ~(granularity - 1);
+    }
+
+    static void advise_huge_pages(void* p, const size_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+        if (bytes >= huge_page_size) {
+            ::madvise(p, bytes, MADV_HUGEPAGE);
+        }
+#endif
+    }
+};
+#endif
+
+// Growth Policies
+// next_capacity(capacity, required, element_size) picks the new capacity when a buffer holding
+// `capacity` elements must grow to fit at least `required`. The result is further rounded up to
+// the allocator's size class when the allocator reports one through good_size().
+
+// Geometric growth by Numerator / Denominator, saturating at the largest representable buffer
+template <size_t Numerator, size_t Denominator = 1>
+struct FactorGrowth {
+    static_assert(Numerator > Denominator, "FactorGrowth: growth factor must be greater than 1");
+
+    static constexpr size_t next_capacity(const size_t capacity, const size_t required, const size_t element_size) noexcept {
+        const size_t limit = static_cast<size_t>(-1) / element_size;
+        const size_t grown = (capacity > limit / Numerator) ? limit : capacity * Numerator / Denominator;
+        return std::max({grown, required, size_t(1)});
+    }
+};
+
+using DoublingGrowth = FactorGrowth<2>;
+using OneAndHalfGrowth = FactorGrowth<3, 2>;
+
+// Grow to exactly what is required; only suitable when the final size is mostly known up front
+struct ExactGrowth {
+    static constexpr size_t next_capacity(const size_t, const size_t required, const size_t) noexcept {
+        return std::max(required, size_t(1));
+    }
+};
+
+// Round buffers of at least one page up to whole pages, so no partial page is ever left unused
+template <class Base = DoublingGrowth, size_t PageSize = 4096>
+struct PageGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "PageGrowth: page size must be a power of two");
+
+    static constexpr size_t next_capacity(const size_t capacity, const size_t required, const size_t element_size) noexcept {
+        const size_t n = Base::next_capacity(capacity, required, element_size);
+        const size_t bytes = n * element_size;
+        if (bytes < PageSize || bytes > static_cast<size_t>(-1) - PageSize) {
+            return n;
+        }
+        return ((bytes + PageSize - 1) & ~(PageSize - 1)) / element_size;
+    }
+};
+
+// Tag selecting default- instead of value-initialization of new elements
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag default_init{};
+
+// Statistics Policies
+// Vector reports its allocation and growth events to a StatsPolicy member. NoStats, the default,
+// ignores them and takes no space; VectorStats (VectorStats.hpp) counts them per vector and adds
+// the totals to a process-wide registry keyed by call-site tag. Building with
+// -DVECTOR_ENABLE_STATS makes VectorStats the default for every Vector. A StatsPolicy must be a
+// literal type with constexpr hooks for Vector to stay usable in constant evaluation; both of these
+// are, and VectorStats reports nothing for vectors that exist only at compile time.
+struct NoStats {
+    constexpr void on_allocate(size_t) noexcept {}          // a heap block of that many bytes
+    constexpr void on_reallocate(size_t) noexcept {}        // the contents changed blocks, copying that many bytes
+    constexpr void on_capacity(size_t) noexcept {}          // capacity grew or shrank to that many bytes
+    constexpr void on_shift(size_t) noexcept {}             // insert or erase moved that many elements
+    constexpr void on_destroy(size_t, size_t) noexcept {}   // final size and capacity, in bytes
+    constexpr void tag(const char*) noexcept {}
+    constexpr void tag(std::source_location = std::source_location::current()) noexcept {}
+};
+
+#if defined(VECTOR_ENABLE_STATS)
+using DefaultStatsPolicy = VectorStats;
+#else
+using DefaultStatsPolicy = NoStats;
+#endif
+
+// Checking Policies
+// How Vector treats precondition violations: popping or peeking into an empty vector, and
+// positions outside the vector in insert and erase. Checked throws (std::runtime_error or
+// std::out_of_range), AssertOnly asserts, so NDEBUG builds drop the check, and Unchecked compiles
+// it away. at() checks under every policy. -DVECTOR_CHECK_POLICY=Unchecked changes the default
+// for the whole build.
+struct Checked {
+    template <typename Exception>
+    static constexpr void require(const bool condition, const char* what) {
+        if (!condition) [[unlikely]] {
+            fail<Exception>(what);
+        }
+    }
+
+    // Kept out of the callers so the throw does not bloat them
+    template <typename Exception>
+    [[noreturn]] static constexpr void fail(const char* what) {
+        throw Exception(what);
+    }
+};
+
+struct AssertOnly {
+    template <typename Exception>
+    static constexpr void require([[maybe_unused]] const bool condition, [[maybe_unused]] const char* what) noexcept {
+        assert(condition && what);
+    }
+};
+
+struct Unchecked {
+    template <typename Exception>
+    static constexpr void require(bool, const char*) noexcept {}
+};
+
+#if defined(VECTOR_CHECK_POLICY)
+using DefaultCheckPolicy = VECTOR_CHECK_POLICY;
+#else
+using DefaultCheckPolicy = Checked;
+#endif
+
+// Parallel Execution
+// Opt-in tag for the bulk operations that split their work across threads, e.g.
+// Vector<int> v(parallel, n, 0). threads == 0 means std::thread::hardware_concurrency().
+struct ParallelTag {
+    unsigned threads = 0;
+};
+
+inline constexpr ParallelTag parallel{};
+
+class ParallelHelper {
+public:
+    // Below this much work per thread, starting a thread costs more than it saves
+    static constexpr size_t min_chunk_bytes = size_t(1) << 20;
+    static constexpr size_t page_bytes = 4096;
+
+    // Split [0, count) into contiguous chunks and run work(begin, end) on each, one chunk per
+    // thread with the calling thread taking the first. Chunks span whole pages, so every page of
+    // fresh storage is first touched by the thread that fills it. work must roll back its own
+    // chunk if it throws; the chunks that did complete are then handed to undo(begin, end) and the
+    // first exception is rethrown.
+    template <typename Work, typename Undo>
+    static void for_each_chunk(const ParallelTag policy, const size_t count, const size_t element_size,
+                               Work&& work, Undo&& undo) {
+        const size_t workers = worker_count(policy, count, element_size);
+        if (workers <= 1) {
+            if (count > 0) work(size_t(0), count);
+            return;
+        }
+
+        const size_t page_elements = std::max<size_t>(1, page_bytes / element_size);
+        const size_t chunk = ((count + workers - 1) / workers + page_elements - 1) / page_elements * page_elements;
+        auto chunk_begin = [&](const size_t w) { return std::min(count, w * chunk); };
+        auto chunk_end = [&](const size_t w) { return std::min(count, (w + 1) * chunk); };
+
+        auto errors = std::make_unique<std::exception_ptr[]>(workers);
+        auto run = [&](const size_t w) {
+            try {
+                if (chunk_begin(w) < chunk_end(w)) work(chunk_begin(w), chunk_end(w));
+            } catch (...) {
+                errors[w] = std::current_exception();
+            }
+        };
+
+        {
+            auto threads = std::make_unique<std::thread[]>(workers - 1);
+            size_t started = 1;
+            try {
+                for (; started < workers; ++started) {
+                    threads[started - 1] = std::thread(run, started);
+                }
+            } catch (...) {
+                // Out of threads: the remaining chunks run here
+            }
+            for (size_t w = started; w < workers; ++w) {
+                run(w);
+            }
+            run(0);
+            for (size_t w = 1; w < started; ++w) {
+                threads[w - 1].join();
+            }
+        }
+
+        std::exception_ptr first_error;
+        for (size_t w = 0; w < workers; ++w) {
+            if (errors[w] && !first_error) first_error = errors[w];
+        }
+        if (first_error) {
+            for (size_t w = 0; w < workers; ++w) {
+                if (!errors[w] && chunk_begin(w) < chunk_end(w)) undo(chunk_begin(w), chunk_end(w));
+            }
+            std::rethrow_exception(first_error);
+        }
+    }
+
+private:
+    static size_t worker_count(const ParallelTag policy, const size_t count, const size_t element_size) {
+        const size_t threads = policy.threads ? policy.threads : std::max(1u, std::thread::hardware_concurrency());
+        const size_t min_chunk = std::max<size_t>(1, min_chunk_bytes / element_size);
+        return std::min(threads, std::max<size_t>(1, count / min_chunk));
+    }
+};
+
+// Element Comparison
+// Fast paths for comparing whole buffers of arithmetic elements. Integers, enums and pointers are
+// equal exactly when their bytes are, so they compare with memcmp and a byte-wise SIMD mismatch
+// search; floating point keeps its own == (NaN, -0.0) and uses a loop the compiler can vectorize.
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+template <typename T>
+inline constexpr bool is_fast_comparable_v = is_bitwise_comparable_v<T> || std::is_floating_point_v<T>;
+
+class CompareHelper {
+public:
+    template <typename T>
+    static bool equal(const T* a, const T* b, const size_t n) noexcept {
+        if constexpr (is_bitwise_comparable_v<T>) {
+            return n == 0 || std::memcmp(a, b, n * sizeof(T)) == 0;
+        } else {
+            return mismatch(a, b, n) == n;
+        }
+    }
+
+    // Index of the first i with !(a[i] == b[i]), or n
+    template <typename T>
+    static size_t mismatch(const T* a, const T* b, const size_t n) noexcept {
+        if constexpr (is_bitwise_comparable_v<T>) {
+            return mismatch_bytes(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b),
+                                  n * sizeof(T)) / sizeof(T);
+        } else {
+            size_t i = 0;
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+            if (n * sizeof(T) >= 32 && has_avx2()) {
+                i = mismatch_float_avx2(a, b, n);
+            }
+#endif
+            // Branch-free inner loop over fixed blocks, locate the element in the block afterwards
+            constexpr size_t block = 64 / sizeof(T);
+            for (; i + block <= n; i += block) {
+                bool differs = false;
+                for (size_t k = 0; k < block; ++k) {
+                    differs |= !(a[i + k] == b[i + k]);
+                }
+                if (differs) break;
+            }
+            for (; i < n; ++i) {
+                if (!(a[i] == b[i])) return i;
+            }
+            return n;
+        }
+    }
+
+private:
+    static size_t mismatch_bytes(const unsigned char* a, const unsigned char* b, const size_t n) noexcept {
+        size_t i = 0;
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+        if (n >= 32 && has_avx2()) {
+            i = mismatch_avx2(a, b, n);
+        }
+#elif defined(VECTOR_HAS_NEON_KERNEL)
+        for (; i + 16 <= n; i += 16) {
+            const uint8x16_t same = vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+            if (vminvq_u8(same) != 0xFF) break;
+        }
+#endif
+        // Finish the block holding the mismatch, or the tail, eight bytes at a time; the lowest set bit of the difference marks the first byte on
+        // little-endian targets, the highest on big-endian ones
+        for (; i + 8 <= n; i += 8) {
+            uint64_t x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            if (const uint64_t diff = x ^ y) {
+                if constexpr (std::endian::native == std::endian::little) {
+                    return i + std::countr_zero(diff) / 8;
+                } else {
+                    return i + std::countl_zero(diff) / 8;
+                }
+            }
+        }
+        for (; i < n; ++i) {
+            if (a[i] != b[i]) return i;
+        }
+        return n;
+    }
+
+#if defined(VECTOR_HAS_AVX2_KERNEL)
+    static bool has_avx2() noexcept {
+#if defined(__AVX2__)
+        return true;
+#else
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+#endif
+    }
+
+    // Returns the offset of the 32-byte block holding the first mismatch if there is one,
+    // otherwise the start of the unprocessed tail
+    __attribute__((target("avx2"))) static size_t mismatch_avx2(const unsigned char* a, const unsigned char* b,
+                                                                const size_t n) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= n; i += 32) {
+            const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y))) != 0xFFFFFFFFu) break;
+        }
+        return i;
+    }
+
+    // Same contract as mismatch_avx2, in elements and with ordered floating-point equality
+    template <typename T>
+    __attribute__((target("avx2"))) static size_t mismatch_float_avx2(const T* a, const T* b, const size_t n) noexcept {
+        constexpr size_t lanes = 32 / sizeof(T);
+        size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            if constexpr (std::is_same_v<T, float>) {
+                const __m256 same = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+                if (_mm256_movemask_ps(same) != 0xFF) break;
+            } else if constexpr (std::is_same_v<T, double>) {
+                const __m256d same = _mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+                if (_mm256_movemask_pd(same) != 0xF) break;
+            } else {
+                break;
+            }
+        }
+        return i;
+    }
+#endif
+};
+
+// Inline Storage
+// Uninitialized room for N elements embedded in the container object
+template <typename T, size_t N, size_t Alignment = alignof(T)>
+struct InlineStorage {
+    alignas(Alignment) unsigned char bytes[N * sizeof(T)];
+
+    InlineStorage() noexcept {}
+
+    T* data() noexcept { return reinterpret_cast<T*>(bytes); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(bytes); }
+};
+
+template <typename T, size_t Alignment>
+struct InlineStorage<T, 0, Alignment> {
+    constexpr T* data() noexcept { return nullptr; }
+    constexpr const T* data() const noexcept { return nullptr; }
+};
+
+// Vector Implementation
+// InlineCapacity > 0 keeps up to that many elements inside the object before spilling to the heap
+// GrowthPolicy decides how much extra capacity reallocation reserves (see FactorGrowth)
+// StatsPolicy receives allocation and growth events (see NoStats)
+// CheckPolicy decides what precondition violations cost (see Checked)
+template <class T, class Allocator = DefaultAllocator<T>, size_t InlineCapacity = 0, class GrowthPolicy = DoublingGrowth,
+          class StatsPolicy = DefaultStatsPolicy, class CheckPolicy = DefaultCheckPolicy>
+class Vector {
+private:
+    using Traits = AllocatorHelper<T, Allocator>;
+
+    [[no_unique_address]] InlineStorage<T, InlineCapacity, Traits::alignment> inline_;
+    T* buffer_;
+    size_t size_;
+    size_t capacity_;
+    [[no_unique_address]] Allocator allocator_;
+    [[no_unique_address]] StatsPolicy stats_;
+
+    constexpr bool is_inline() const noexcept {
+        if constexpr (InlineCapacity > 0) return buffer_ == inline_.data();
+        else return false;
+    }
+
+    // Return the current heap block, if any, to the allocator
+    constexpr void deallocate_buffer() noexcept {
+        if (buffer_ && !is_inline()) {
+            Traits::deallocate(buffer_, allocator_, capacity_);
+        }
+    }
+
+    // Capacity to grow to so that `required` elements fit
+    constexpr size_t grown_capacity(const size_t required) const {
+        const size_t proposed = GrowthPolicy::next_capacity(capacity_, required, sizeof(T));
+        return Traits::good_size(allocator_, std::max(proposed, required));
+    }
+
+    // Relocate the elements into a buffer of new_capacity (>= size_) elements; capacities that
+    // fit the inline buffer move the elements back into it
+    constexpr void reallocate(size_t new_capacity) {
+        // Allocators that move whole blocks (mremap) need no element-wise relocation
+        if constexpr (Traits::can_reallocate) {
+            if (new_capacity > InlineCapacity && buffer_ && !is_inline()) {
+                if (T* moved = Traits::reallocate(buffer_, allocator_, capacity_, new_capacity)) {
+                    stats_.on_reallocate(0);
+                    stats_.on_capacity(new_capacity * sizeof(T));
+                    buffer_ = moved;
+                    capacity_ = new_capacity;
+                    return;
+                }
+            }
+        }
+
+        T* new_buffer = inline_.data();
+        if (new_capacity <= InlineCapacity) {
+            new_capacity = InlineCapacity;
+        } else {
+            Traits::allocate(new_buffer, allocator_, new_capacity);
+            stats_.on_allocate(new_capacity * sizeof(T));
+        }
+
+        try {
+            Traits::relocate(new_buffer, buffer_, size_, allocator_);
+        } catch (...) {
+            // The elements are still in the old buffer
+            if (new_buffer != inline_.data()) Traits::deallocate(new_buffer, allocator_, new_capacity);
+            throw;
+        }
+        if (size_ > 0) stats_.on_reallocate(size_ * sizeof(T));
+        stats_.on_capacity(new_capacity * sizeof(T));
+
+        deallocate_buffer();
+
+        buffer_ = new_buffer;
+        capacity_ = new_capacity;
+    }
+
+    // Destroy the elements from new_size onwards
+    constexpr void destroy_tail(const size_t new_size) noexcept {
+        for (size_t i = new_size; i < size_; ++i) {
+            Traits::destroy(&buffer_[i], allocator_);
+        }
+        size_ = new_size;
+    }
+
+    // Destroy all elements and hand the buffer back to the allocator that produced it
+    constexpr void destroy_and_deallocate() noexcept {
+        for (size_t i = 0; i < size_; ++i) {
+            Traits::destroy(&buffer_[i], allocator_);
+        }
+        deallocate_buffer();
+        buffer_ = inline_.data();
+        size_ = 0;
+        capacity_ = InlineCapacity;
+    }
+
+    // Copy other into this empty vector with an exact-fit buffer; the copy does not inherit
+    // other's slack. Nothing is left allocated if a copy throws.
+    constexpr void copy_from(const Vector& other) {
+        if (other.size_ > 0) {
+            reserve(other.size_);
+            try {
+                construct_range(buffer_, other.buffer_, other.size_);
+            } catch (...) {
+                destroy_and_deallocate();
+                throw;
+            }
+            size_ = other.size_;
+        }
+    }
+
+    // Element-wise move used when storage cannot change hands between unequal allocators
+    constexpr void move_elements_from(Vector& other) {
+        if (other.size_ > 0) {
+            reserve(other.size_);
+            try {
+                construct_range(buffer_, std::make_move_iterator(other.buffer_), other.size_);
+            } catch (...) {
+                destroy_and_deallocate();
+                throw;
+            }
+            size_ = other.size_;
+        }
+    }
+
+    // Overwrite the contents with count elements copied (or moved) from source, which must not
+    // alias this vector. A large enough buffer is kept: the common prefix is assigned over and
+    // only the difference is constructed or destroyed; trivially copyable T is one memcpy.
+    // Otherwise the old buffer is released before the exact-fit one is allocated.
+    template <bool Move>
+    constexpr void assign_elements(std::conditional_t<Move, T*, const T*> source, const size_t count) {
+        if (count > capacity_) {
+            destroy_and_deallocate();
+            reserve(count);
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                if (count > 0)
+                    StreamHelper::copy(static_cast<void*>(buffer_), static_cast<const void*>(source), count * sizeof(T));
+                size_ = count;
+                return;
+            }
+        }
+        const size_t common = std::min(size_, count);
+        if constexpr (Move) {
+            std::move(source, source + common, buffer_);
+        } else {
+            std::copy(source, source + common, buffer_);
+        }
+        if (count > size_) {
+            if constexpr (Move) {
+                construct_range(buffer_ + size_, std::make_move_iterator(source + size_), count - size_);
+            } else {
+                construct_range(buffer_ + size_, source + size_, count - size_);
+            }
+            size_ = count;
+        } else {
+            destroy_tail(count);
+        }
+    }
+
+    // Take over other's contents; *this must be empty and using its inline buffer
+    constexpr void steal_from(Vector& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if (other.is_inline()) {
+            // Inline elements live inside `other`, so they have to be moved one by one
+            Traits::relocate(buffer_, other.buffer_, other.size_, allocator_);
+            size_ = other.size_;
+            other.size_ = 0;
+            return;
+        }
+        buffer_ = other.buffer_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.buffer_ = other.inline_.data();
+        other.size_ = 0;
+        other.capacity_ = InlineCapacity;
+    }
+
+    // Make room for `length` more elements with a single reservation; an empty vector gets an
+    // exact fit, otherwise the growth policy applies
+    constexpr void reserve_for_append(const size_t length) {
+        if (length > capacity_ - size_) {
+            reserve((size_ == 0) ? length : grown_capacity(size_ + length));
+        }
+    }
+
+    // Construct n elements read from first into uninitialized dest. A contiguous source of
+    // trivially copyable T is a single memcpy; otherwise a partial copy is rolled back on throw.
+    template <typename Iterator>
+    constexpr void construct_range(T* dest, Iterator first, const size_t n) {
+        if constexpr (std::contiguous_iterator<Iterator> && std::is_trivially_copyable_v<T> &&
+                      std::is_same_v<std::iter_value_t<Iterator>, T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n > 0)
+                    StreamHelper::copy(static_cast<void*>(dest), static_cast<const void*>(std::to_address(first)), n * sizeof(T));
+                return;
+            }
+        }
+        size_t i = 0;
+        try {
+            for (; i < n; ++i, ++first) {
+                Traits::construct(dest + i, allocator_, *first);
+            }
+        } catch (...) {
+            while (i > 0) {
+                Traits::destroy(dest + --i, allocator_);
+            }
+            throw;
+        }
+    }
+
+    // Construct n copies of value into uninitialized dest, rolling back on throw. Large fills of
+    // trivially copyable T use streaming stores.
+    constexpr void construct_fill(T* dest, const size_t n, const T& value) {
+        if constexpr (StreamHelper::can_fill<T>) {
+            if (!std::is_constant_evaluated() && StreamHelper::streams_fill(n * sizeof(T))) {
+                StreamHelper::fill(dest, n, value);
+                return;
+            }
+        }
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                Traits::construct(dest + i, allocator_, value);
+            }
+        } catch (...) {
+            while (i > 0) {
+                Traits::destroy(dest + --i, allocator_);
+            }
+            throw;
+        }
+    }
+
+    // Construct `count` elements at the start of the (empty) buffer, chunk by chunk across threads;
+    // construct_chunk(begin, end) must roll back its own chunk on throw
+    template <typename ConstructChunk>
+    void parallel_construct(const ParallelTag policy, const size_t count, ConstructChunk&& construct_chunk) {
+        ParallelHelper::for_each_chunk(policy, count, sizeof(T), construct_chunk, [this](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Traits::destroy(&buffer_[i], allocator_);
+            }
+        });
+        size_ = count;
+    }
+
+    // Let an allocator that supports it extend the current heap block to new_capacity
+    constexpr bool try_expand(const size_t new_capacity) {
+        if (buffer_ && !is_inline() && Traits::expand(buffer_, allocator_, capacity_, new_capacity)) {
+            stats_.on_capacity(new_capacity * sizeof(T));
+            capacity_ = new_capacity;
+            return true;
+        }
+        return false;
+    }
+
+    // Reallocate for `count` more elements with the gap at index already in place. The new
+    // elements are built first by construct_gap(gap) - their sources may be our own elements -
+    // and then both halves are relocated around them, so nothing is moved twice.
+    template <typename ConstructGap>
+    constexpr void grow_with_gap(const size_t index, const size_t count, ConstructGap&& construct_gap) {
+        const size_t new_capacity = grown_capacity(size_ + count);
+        T* new_buffer = nullptr;
+        Traits::allocate(new_buffer, allocator_, new_capacity);
+        try {
+            construct_gap(new_buffer + index);
+        } catch (...) {
+            Traits::deallocate(new_buffer, allocator_, new_capacity);
+            throw;
+        }
+
+        if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+            Traits::relocate(new_buffer, buffer_, index, allocator_);
+            Traits::relocate(new_buffer + index + count, buffer_ + index, size_ - index, allocator_);
+        } else {
+            // A throwing move must not strand elements in both buffers: build both sides of the gap
+            // before any original is destroyed
+            const auto slot = [&](const size_t i) { return new_buffer + i + (i < index ? 0 : count); };
+            size_t built = 0;
+            try {
+                for (; built < size_; ++built) {
+                    Traits::construct(slot(built), allocator_, std::move_if_noexcept(buffer_[built]));
+                }
+            } catch (...) {
+                while (built > 0) {
+                    Traits::destroy(slot(--built), allocator_);
+                }
+                for (size_t i = index; i < index + count; ++i) {
+                    Traits::destroy(new_buffer + i, allocator_);
+                }
+                Traits::deallocate(new_buffer, allocator_, new_capacity);
+                throw;
+            }
+            for (size_t i = 0; i < size_; ++i) {
+                Traits::destroy(buffer_ + i, allocator_);
+            }
+        }
+        stats_.on_allocate(new_capacity * sizeof(T));
+        if (size_ > 0) stats_.on_reallocate(size_ * sizeof(T));
+        stats_.on_capacity(new_capacity * sizeof(T));
+
+        deallocate_buffer();
+
+        buffer_ = new_buffer;
+        size_ += count;
+        capacity_ = new_capacity;
+    }
+
+    // Open `count` slots at index within the current capacity and fill them from next(), for
+    // types that are not trivially relocatable: the tail is shifted with std::move_backward, so only
+    // slots past the old end are constructed and the rest are assigned over. If a constructor or
+    // assignment throws, the slots built past the old end are destroyed and size() is unchanged;
+    // the elements already shifted or assigned keep valid but unspecified values.
+    template <typename Next>
+    constexpr void fill_gap(const size_t index, const size_t count, Next&& next) {
+        const size_t moved = std::min(count, size_ - index);
+        // The moved tail lands in [tail, size_ + count); [size_, tail) is built from next()
+        const size_t tail = size_ + count - moved;
+        size_t built = tail;
+        size_t filled = size_;
+        try {
+            for (size_t i = size_ - moved; i < size_; ++i, ++built) {
+                Traits::construct(buffer_ + built, allocator_, std::move(buffer_[i]));
+            }
+            std::move_backward(buffer_ + index, buffer_ + size_ - moved, buffer_ + size_ - moved + count);
+
+            for (size_t i = 0; i < moved; ++i) {
+                buffer_[index + i] = next();
+            }
+            for (; filled < tail; ++filled) {
+                Traits::construct(buffer_ + filled, allocator_, next());
+            }
+        } catch (...) {
+            while (built > tail) {
+                Traits::destroy(buffer_ + --built, allocator_);
+            }
+            while (filled > size_) {
+                Traits::destroy(buffer_ + --filled, allocator_);
+            }
+            throw;
+        }
+        size_ += count;
+    }
+
+    // Single-element insertion when there is spare capacity
+    template <typename... Args>
+    constexpr void emplace_in_place(const size_t index, Args&&... args) {
+        if (index == size_) {
+            Traits::construct(buffer_ + size_, allocator_, std::forward<Args>(args)...);
+            ++size_;
+            return;
+        }
+
+        // Build the value first: args may refer to elements that are about to shift
+        T value(std::forward<Args>(args)...);
+        stats_.on_shift(size_ - index);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Traits::relocate_overlapping(buffer_ + index + 1, buffer_ + index, size_ - index, allocator_);
+            Traits::construct(buffer_ + index, allocator_, std::move(value));
+        } else {
+            Traits::construct(buffer_ + size_, allocator_, std::move(buffer_[size_ - 1]));
+            try {
+                std::move_backward(buffer_ + index, buffer_ + size_ - 1, buffer_ + size_);
+                buffer_[index] = std::move(value);
+            } catch (...) {
+                Traits::destroy(buffer_ + size_, allocator_);
+                throw;
+            }
+        }
+        ++size_;
+    }
+
+    template <typename... Args>
+    constexpr void emplace_at_index(const size_t index, Args&&... args) {
+        if (size_ == capacity_ && !try_expand(grown_capacity(size_ + 1))) {
+            if constexpr (Traits::can_reallocate) {
+                if (buffer_ && !is_inline()) {
+                    // args may refer to elements the allocator is about to move
+                    T value(std::forward<Args>(args)...);
+                    reallocate(grown_capacity(size_ + 1));
+                    emplace_in_place(index, std::move(value));
+                    return;
+                }
+            }
+            grow_with_gap(index, 1, [&](T* slot) {
+                Traits::construct(slot, allocator_, std::forward<Args>(args)...);
+            });
+            return;
+        }
+        emplace_in_place(index, std::forward<Args>(args)...);
+    }
+
+    // Insert `count` elements read from first at index; the source must not be this vector
+    template <typename Iterator>
+    constexpr void insert_counted(const size_t index, Iterator first, const size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (count > capacity_ - size_ && !try_expand(grown_capacity(size_ + count))) {
+            grow_with_gap(index, count, [&](T* gap) { construct_range(gap, first, count); });
+            return;
+        }
+        stats_.on_shift(size_ - index);
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Traits::relocate_overlapping(buffer_ + index + count, buffer_ + index, size_ - index, allocator_);
+            try {
+                construct_range(buffer_ + index, first, count);
+            } catch (...) {
+                Traits::relocate_overlapping(buffer_ + index, buffer_ + index + count, size_ - index, allocator_);
+                throw;
+            }
+            size_ += count;
+        } else {
+            fill_gap(index, count, [&first]() -> decltype(auto) { return *first++; });
+        }
+    }
+
+    // Insert a single-pass sequence of unknown length at index: append, then rotate the new
+    // elements into place. The sentinel may differ in type from the iterator.
+    template <typename Iterator, typename Sentinel>
+    constexpr void insert_single_pass(const size_t index, Iterator first, const Sentinel last) {
+        const size_t old_size = size_;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        stats_.on_shift(old_size - index);
+        std::rotate(begin() + index, begin() + old_size, end());
+    }
+
+    template <std::ranges::range R>
+    constexpr void add_range(R&& r, bool clear_before) {
+        if (clear_before) clear();
+
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            const size_t length = static_cast<size_t>(std::ranges::distance(r));
+            if (length == 0) {
+                return; // Allow empty ranges
+            }
+            reserve_for_append(length);
+            construct_range(buffer_ + size_, std::ranges::begin(r), length);
+            size_ += length;
+        } else {
+            // Single-pass range of unknown length: the growth policy amortizes the reallocations
+            for (auto&& element : r) {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
+public:
+    using ValueType = T;
+    using Iterator = T*;
+    using ConstIterator = const T*;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+    using SizeType = size_t;
+    using DifferenceType = ptrdiff_t;
+    using AllocatorType = Allocator;
+    using Pointer = typename Traits::Pointer;
+    using ConstPointer = typename Traits::ConstPointer;
+
+    // Standard spellings, so std algorithms and adapters (back_inserter, ranges::to) see a container
+    using value_type = T;
+    using size_type = SizeType;
+    using difference_type = DifferenceType;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+    using reverse_iterator = ReverseIterator;
+    using const_reverse_iterator = ConstReverseIterator;
+    using allocator_type = Allocator;
+
+    // Guaranteed alignment of data(); raise it with AlignedAllocator
+    static constexpr size_t data_alignment = Traits::alignment;
+
+    constexpr Vector() noexcept(std::is_nothrow_default_constructible<Allocator>::value)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(Allocator()) {
+    }
+
+    constexpr explicit Vector(const Allocator& alloc) noexcept
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+    }
+
+    constexpr Vector(size_t n, const T& value, const Allocator& alloc = Allocator())
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+        if (n > 0) {
+            // Sized construction allocates exactly what it needs; slack only comes from growth
+            reserve(n);
+            try {
+                construct_fill(buffer_, n, value);
+            } catch (...) {
+                destroy_and_deallocate();
+                throw;
+            }
+            size_ = n;
+        }
+    }
+
+    // n default-initialized elements; trivial types are left unwritten
+    constexpr Vector(size_t n, DefaultInitTag, const Allocator& alloc = Allocator())
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+        try {
+            resize_default_init(n);
+        } catch (...) {
+            // The elements constructed so far are counted in size_
+            destroy_and_deallocate();
+            throw;
+        }
+    }
+
+    // Parallel fill: n copies of value constructed by several threads
+    Vector(ParallelTag policy, size_t n, const T& value, const Allocator& alloc = Allocator())
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+        try {
+            assign(policy, n, value);
+        } catch (...) {
+            deallocate_buffer();
+            throw;
+        }
+    }
+
+    constexpr Vector(const Vector& other)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(Traits::select_on_copy_construction(other.allocator_)) {
+        copy_from(other);
+    }
+
+    // Parallel copy: the elements of other are copied by several threads into an exactly sized buffer
+    Vector(ParallelTag policy, const Vector& other)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(Traits::select_on_copy_construction(other.allocator_)) {
+        reserve(other.size_);
+        try {
+            parallel_construct(policy, other.size_, [this, &other](size_t begin, size_t end) {
+                construct_range(buffer_ + begin, other.buffer_ + begin, end - begin);
+            });
+        } catch (...) {
+            deallocate_buffer();
+            throw;
+        }
+    }
+
+    constexpr Vector(const Vector& other, const Allocator& alloc)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+        copy_from(other);
+    }
+
+    constexpr Vector(Vector&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(std::move(other.allocator_)) {
+        steal_from(other);
+    }
+
+    constexpr Vector(Vector&& other, const Allocator& alloc)
+        : buffer_(inline_.data()), size_(0), capacity_(InlineCapacity), allocator_(alloc) {
+        if (Traits::equal(allocator_, other.allocator_)) {
+            steal_from(other);
+        } else {
+            move_elements_from(other);
+        }
+    }
+
+    constexpr Vector& operator=(const Vector& other) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_copy_assignment) {
+                if (!Traits::equal(allocator_, other.allocator_)) {
+                    // Our storage belongs to the allocator being replaced
+                    destroy_and_deallocate();
+                }
+                allocator_ = other.allocator_;
+            }
+            assign_elements<false>(other.buffer_, other.size_);
+        }
+        return *this;
+    }
+
+    constexpr Vector& operator=(Vector&& other) noexcept((Traits::propagate_on_move_assignment || Traits::is_always_equal) &&
+                                                         (InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)) {
+        if (this != &other) {
+            if constexpr (Traits::propagate_on_move_assignment) {
+                destroy_and_deallocate();
+                allocator_ = std::move(other.allocator_);
+                steal_from(other);
+            } else {
+                if (Traits::equal(allocator_, other.allocator_)) {
+                    destroy_and_deallocate();
+                    steal_from(other);
+                } else {
+                    // Storage cannot change hands; reuse ours and move the elements over
+                    assign_elements<true>(other.buffer_, other.size_);
+                }
+            }
+        }
+        return *this;
+    }
+
+    constexpr bool operator==(const Vector& other) const {
+        if (size_ != other.size_) return false;
+        if constexpr (is_fast_comparable_v<T>) {
+            if (!std::is_constant_evaluated()) return CompareHelper::equal(buffer_, other.buffer_, size_);
+        }
+        for (SizeType i = 0; i < size_; ++i) {
+            if (!(buffer_[i] == other.buffer_[i])) return false;
+        }
+        return true;
+    }
+
+    constexpr auto operator<=>(const Vector& other) const {
+        if constexpr (is_fast_comparable_v<T>) {
+            if (!std::is_constant_evaluated()) {
+                // Vector compare up to the first mismatch, then a scalar tie-break
+                using Result = std::compare_three_way_result_t<T>;
+                const SizeType common = std::min(size_, other.size_);
+                const SizeType index = CompareHelper::mismatch(buffer_, other.buffer_, common);
+                if (index < common) return static_cast<Result>(buffer_[index] <=> other.buffer_[index]);
+                return static_cast<Result>(size_ <=> other.size_);
+            }
+        }
+        return std::lexicographical_compare_three_way(begin(), end(), other.begin(), other.end());
+    }
+
+    constexpr SizeType size() const noexcept { return size_; }
+    constexpr SizeType capacity() const noexcept { return capacity_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    // Aligned to data_alignment, inline or on the heap
+    constexpr T* data() noexcept { return std::assume_aligned<data_alignment>(buffer_); }
+    constexpr const T* data() const noexcept { return std::assume_aligned<data_alignment>(buffer_); }
+
+    constexpr Iterator begin() noexcept { return buffer_; }
+    constexpr ConstIterator begin() const noexcept { return buffer_; }
+    constexpr ConstIterator cbegin() const noexcept { return buffer_; }
+
+    constexpr Iterator end() noexcept { return buffer_ + size_; }
+    constexpr ConstIterator end() const noexcept { return buffer_ + size_; }
+    constexpr ConstIterator cend() const noexcept { return buffer_ + size_; }
+
+    constexpr ReverseIterator rbegin() noexcept { return ReverseIterator(end()); }
+    constexpr ConstReverseIterator rbegin() const noexcept { return ConstReverseIterator(end()); }
+    constexpr ConstReverseIterator crbegin() const noexcept { return ConstReverseIterator(end()); }
+
+    constexpr ReverseIterator rend() noexcept { return ReverseIterator(begin()); }
+    constexpr ConstReverseIterator rend() const noexcept { return ConstReverseIterator(begin()); }
+    constexpr ConstReverseIterator crend() const noexcept { return ConstReverseIterator(begin()); }
+
+    // The elements as a span; Vector is also a contiguous sized range, so std::span<T> s = v works
+    constexpr std::span<T> span() noexcept { return {buffer_, size_}; }
+    constexpr std::span<const T> span() const noexcept { return {buffer_, size_}; }
+
+    constexpr T& operator[](SizeType index) { return buffer_[index]; }
+    constexpr const T& operator[](SizeType index) const { return buffer_[index]; }
+
+    // Bounds-checked access, whatever the CheckPolicy
+    constexpr T& at(SizeType index) {
+        if (index >= size_) {
+            Checked::fail<std::out_of_range>("Index out of range");
+        }
+        return buffer_[index];
+    }
+
+    constexpr const T& at(SizeType index) const {
+        if (index >= size_) {
+            Checked::fail<std::out_of_range>("Index out of range");
+        }
+        return buffer_[index];
+    }
+
+    constexpr void insert_at(SizeType index, const T& value) {
+        CheckPolicy::template require<std::out_of_range>(index <= size_, "Insert index out of range");
+        emplace_at_index(index, value);
+    }
+
+    constexpr Iterator insert(ConstIterator pos, const T& value) {
+        return emplace_at(pos, value);
+    }
+
+    constexpr Iterator insert(ConstIterator pos, T&& value) {
+        return emplace_at(pos, std::move(value));
+    }
+
+    // Insert count copies of value before pos
+    constexpr Iterator insert(ConstIterator pos, SizeType count, const T& value) {
+        CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos <= cend(), "Insert position is out of range");
+        const SizeType index = std::distance(cbegin(), pos);
+        if (count == 0) {
+            return begin() + index;
+        }
+
+        if (count > capacity_ - size_ && !try_expand(grown_capacity(size_ + count))) {
+            grow_with_gap(index, count, [&](T* gap) { construct_fill(gap, count, value); });
+            return begin() + index;
+        }
+
+        // value may be one of the elements about to shift
+        const T copy(value);
+        stats_.on_shift(size_ - index);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Traits::relocate_overlapping(buffer_ + index + count, buffer_ + index, size_ - index, allocator_);
+            try {
+                construct_fill(buffer_ + index, count, copy);
+            } catch (...) {
+                Traits::relocate_overlapping(buffer_ + index, buffer_ + index + count, size_ - index, allocator_);
+                throw;
+            }
+            size_ += count;
+        } else {
+            fill_gap(index, count, [&copy]() -> const T& { return copy; });
+        }
+        return begin() + index;
+    }
+
+    constexpr void assign(SizeType count, const T& value) {
+        clear();
+        if (count > capacity_) {
+            reserve(count);
+        }
+        construct_fill(buffer_, count, value);
+        size_ = count;
+    }
+
+    void assign(ParallelTag policy, SizeType count, const T& value) {
+        clear();
+        if (count > capacity_) {
+            reserve(count);
+        }
+        parallel_construct(policy, count, [this, &value](size_t begin, size_t end) {
+            construct_fill(buffer_ + begin, end - begin, value);
+        });
+    }
+
+    template <typename... Args>
+    constexpr void emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            // Grows and constructs in one pass, so args may refer to our own elements
+            emplace_at_index(size_, std::forward<Args>(args)...);
+            return;
+        }
+        Traits::construct(&buffer_[size_], allocator_, std::forward<Args>(args)...);
+        ++size_;
+    }
+
+    constexpr void reserve(SizeType new_capacity) {
+        if (new_capacity <= capacity_) return;
+
+        // Allocators that can extend the block in place spare us the relocation
+        if (!try_expand(new_capacity)) {
+            reallocate(new_capacity);
+        }
+    }
+
+    // reserve() whose relocation is split across threads, each writing its own pages of the new
+    // buffer. Types whose move may throw cannot be relocated piecewise and fall back to reserve().
+    void reserve(ParallelTag policy, SizeType new_capacity) {
+        if (new_capacity <= capacity_ || try_expand(new_capacity)) return;
+        if constexpr (!is_trivially_relocatable_v<T> && !std::is_nothrow_move_constructible_v<T>) {
+            reallocate(new_capacity);
+        } else {
+            T* new_buffer = nullptr;
+            Traits::allocate(new_buffer, allocator_, new_capacity);
+            stats_.on_allocate(new_capacity * sizeof(T));
+            ParallelHelper::for_each_chunk(policy, size_, sizeof(T),
+                [this, new_buffer](size_t begin, size_t end) {
+                    Traits::relocate(new_buffer + begin, buffer_ + begin, end - begin, allocator_);
+                },
+                [](size_t, size_t) {});
+            if (size_ > 0) stats_.on_reallocate(size_ * sizeof(T));
+            stats_.on_capacity(new_capacity * sizeof(T));
+
+            deallocate_buffer();
+
+            buffer_ = new_buffer;
+            capacity_ = new_capacity;
+        }
+    }
+
+    // Give unused capacity back to the allocator
+    constexpr void shrink_to_fit() {
+        if (size_ == capacity_ || is_inline()) return;
+        reallocate(size_);
+    }
+
+    template <typename... Args>
+    constexpr Iterator emplace_at(ConstIterator pos, Args&&... args) {
+        size_t index = std::distance(cbegin(), pos);
+
+        CheckPolicy::template require<std::out_of_range>(index <= size_, "Insert position is out of range");
+
+        emplace_at_index(index, std::forward<Args>(args)...);
+
+        return buffer_ + index;
+    }
+
+    constexpr Allocator get_allocator() const {
+        return allocator_;
+    }
+
+    // This vector's statistics; they describe this object only and are not copied, moved or swapped
+    constexpr StatsPolicy& stats() noexcept { return stats_; }
+    constexpr const StatsPolicy& stats() const noexcept { return stats_; }
+
+    constexpr void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            Traits::destroy(&buffer_[i], allocator_);
+        }
+        size_ = 0;
+        // Don't deallocate buffer or reset capacity - just clear contents
+    }
+
+    // Like clear(), but also returns the buffer to the allocator
+    constexpr void clear_and_release() noexcept {
+        destroy_and_deallocate();
+    }
+
+    // Shrink by destroying trailing elements, or grow by value-initializing new ones
+    constexpr void resize(SizeType new_size) {
+        if (new_size <= size_) {
+            destroy_tail(new_size);
+            return;
+        }
+        if (new_size > capacity_) {
+            reserve(grown_capacity(new_size));
+        }
+        while (size_ < new_size) {
+            Traits::construct(&buffer_[size_], allocator_);
+            ++size_;
+        }
+    }
+
+    // Like resize(), but new elements are default-initialized, so trivial types skip the zero-fill
+    constexpr void resize_default_init(SizeType new_size) {
+        if (new_size <= size_) {
+            destroy_tail(new_size);
+            return;
+        }
+        if (new_size > capacity_) {
+            reserve(grown_capacity(new_size));
+        }
+        while (size_ < new_size) {
+            Traits::construct_default(&buffer_[size_], allocator_);
+            ++size_;
+        }
+    }
+
+    // Make room for n more elements and return the raw storage just past end(). The size is left
+    // unchanged until commit_append() publishes what was written there, e.g. by read()/recv().
+    constexpr T* append_uninitialized(SizeType n) {
+        if (n > capacity_ - size_) {
+            reserve(grown_capacity(size_ + n));
+        }
+        return buffer_ + size_;
+    }
+
+    // Publish n elements that were constructed (or, for trivial types, written) in the storage
+    // returned by append_uninitialized()
+    constexpr void commit_append(SizeType n) {
+        CheckPolicy::template require<std::out_of_range>(n <= capacity_ - size_, "Committed elements exceed reserved capacity");
+        size_ += n;
+    }
+
+    constexpr void resize(SizeType new_size, const T& value) {
+        if (new_size <= size_) {
+            destroy_tail(new_size);
+            return;
+        }
+        if (new_size > capacity_) {
+            // value may be one of our own elements, which reserve is about to relocate
+            const T copy(value);
+            reserve(grown_capacity(new_size));
+            while (size_ < new_size) {
+                Traits::construct(&buffer_[size_], allocator_, copy);
+                ++size_;
+            }
+            return;
+        }
+        while (size_ < new_size) {
+            Traits::construct(&buffer_[size_], allocator_, value);
+            ++size_;
+        }
+    }
+
+    // Without allocator propagation on swap the two allocators must compare equal, as for std containers
+    constexpr void swap(Vector& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>) {
+        if constexpr (InlineCapacity > 0) {
+            if (is_inline() || other.is_inline()) {
+                // Inline elements cannot trade places by pointer; go through a temporary
+                Vector tmp(std::move(other));
+                // The move left other's allocator unspecified; settle both allocators before any
+                // element is relocated with them
+                other.allocator_ = tmp.allocator_;
+                if constexpr (Traits::propagate_on_swap) {
+                    using std::swap;
+                    swap(allocator_, other.allocator_);
+                }
+                other.steal_from(*this);
+                steal_from(tmp);
+                return;
+            }
+        }
+        std::swap(buffer_, other.buffer_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        if constexpr (Traits::propagate_on_swap) {
+            using std::swap;
+            swap(allocator_, other.allocator_);
+        }
+    }
+
+    constexpr ~Vector() {
+        stats_.on_destroy(size_ * sizeof(T), capacity_ * sizeof(T));
+        destroy_and_deallocate();
+    }
+
+    // Insert [first, last) before pos and return an iterator to the first inserted element
+    template <std::input_iterator InputIterator>
+    constexpr Iterator insert(ConstIterator pos, InputIterator first, InputIterator last) {
+        CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos <= cend(), "Insert position is out of range");
+        const SizeType index = std::distance(cbegin(), pos);
+
+        if constexpr (std::forward_iterator<InputIterator>) {
+            insert_counted(index, first, static_cast<SizeType>(std::distance(first, last)));
+        } else {
+            insert_single_pass(index, std::move(first), last);
+        }
+        return begin() + index;
+    }
+
+    // Insert the elements of r before pos
+    template <std::ranges::range R>
+    constexpr Iterator insert_range(ConstIterator pos, R&& r) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos <= cend(), "Insert position is out of range");
+            const SizeType index = std::distance(cbegin(), pos);
+            insert_counted(index, std::ranges::begin(r), static_cast<SizeType>(std::ranges::distance(r)));
+            return begin() + index;
+        } else {
+            CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos <= cend(), "Insert position is out of range");
+            const SizeType index = std::distance(cbegin(), pos);
+            insert_single_pass(index, std::ranges::begin(r), std::ranges::end(r));
+            return begin() + index;
+        }
+    }
+
+    template <std::ranges::range R>
+    constexpr void assign_range(R&& r) {
+        add_range(std::forward<R>(r), true);
+    }
+
+    template <std::ranges::range R>
+    constexpr void append_range(R&& r) {
+        add_range(std::forward<R>(r), false);
+    }
+
+    constexpr void erase(ConstIterator pos) {
+        CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos < cend(), "Iterator out of range");
+
+        SizeType index = std::distance(cbegin(), pos);
+        stats_.on_shift(size_ - index - 1);
+
+        // Move elements down
+        if constexpr (is_trivially_relocatable_v<T>) {
+            Traits::destroy(&buffer_[index], allocator_);
+            Traits::relocate_overlapping(buffer_ + index, buffer_ + index + 1, size_ - index - 1, allocator_);
+        } else {
+            std::move(buffer_ + index + 1, buffer_ + size_, buffer_ + index);
+            Traits::destroy(&buffer_[size_ - 1], allocator_);
+        }
+
+        --size_;
+    }
+
+    constexpr void erase(ConstIterator first, ConstIterator last) {
+        CheckPolicy::template require<std::out_of_range>(first >= cbegin() && last <= cend() && first <= last,
+                                                         "Invalid erase range");
+
+        size_t start = std::distance(cbegin(), first);
+        size_t end = std::distance(cbegin(), last);
+        size_t count = end - start;
+        if (count == 0) {
+            return;
+        }
+        stats_.on_shift(size_ - end);
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // Destroy elements in range
+            for (size_t i = start; i < end; ++i) {
+                Traits::destroy(&buffer_[i], allocator_);
+            }
+
+            // Move elements after `last` to `first`
+            Traits::relocate_overlapping(buffer_ + start, buffer_ + end, size_ - end, allocator_);
+            size_ -= count;
+        } else {
+            // Move elements after `last` to `first`, then destroy the vacated tail
+            std::move(buffer_ + end, buffer_ + size_, buffer_ + start);
+            destroy_tail(size_ - count);
+        }
+    }
+
+    // Remove pos in O(1) by moving the last element into its place; the order of the remaining
+    // elements is not preserved
+    constexpr void swap_erase(ConstIterator pos) {
+        CheckPolicy::template require<std::out_of_range>(pos >= cbegin() && pos < cend(), "Iterator out of range");
+
+        const SizeType index = std::distance(cbegin(), pos);
+        if (index != size_ - 1) {
+            buffer_[index] = std::move(buffer_[size_ - 1]);
+        }
+        Traits::destroy(&buffer_[size_ - 1], allocator_);
+        --size_;
+    }
+
+    // Remove every element matching pred in one pass: each survivor is moved at most once and
+    // the vacated tail is destroyed in bulk. Returns the number of elements removed.
+    template <typename Pred>
+    constexpr SizeType remove_if(Pred pred) {
+        size_t out = 0;
+        while (out < size_ && !pred(buffer_[out])) {
+            ++out;
+        }
+        if (out == size_) {
+            return 0;
+        }
+
+        const size_t old_size = size_;
+        const size_t first_removed = out;
+        size_t read = out + 1;
+        try {
+            for (; read < size_; ++read) {
+                if (!pred(buffer_[read])) {
+                    buffer_[out] = std::move(buffer_[read]);
+                    ++out;
+                }
+            }
+        } catch (...) {
+            // Keep the elements not yet visited, closing the gap in front of them
+            std::move(buffer_ + read, buffer_ + size_, buffer_ + out);
+            destroy_tail(out + (size_ - read));
+            throw;
+        }
+        stats_.on_shift(out - first_removed);
+        destroy_tail(out);
+        return old_size - size_;
+    }
+
+    constexpr SizeType remove(const T& value) {
+        return remove_if([&value](const T& element) { return element == value; });
+    }
+
+    // Remove the elements at the given indices, which must be strictly increasing, moving each
+    // survivor at most once. The indices are validated before anything moves.
+    template <std::ranges::forward_range R>
+        requires std::integral<std::ranges::range_value_t<R>>
+    constexpr SizeType erase_indices(const R& indices) {
+        size_t expected = 0;
+        for (const auto index : indices) {
+            CheckPolicy::template require<std::out_of_range>(
+                    std::in_range<size_t>(index) && static_cast<size_t>(index) >= expected &&
+                            static_cast<size_t>(index) < size_,
+                    "Erase indices must be increasing and in range");
+            expected = static_cast<size_t>(index) + 1;
+        }
+
+        auto it = std::ranges::begin(indices);
+        const auto last = std::ranges::end(indices);
+        if (it == last) {
+            return 0;
+        }
+
+        // Elements [read, next) survive and move down to out
+        const size_t old_size = size_;
+        size_t out = static_cast<size_t>(*it);
+        size_t read = out + 1;
+        for (++it; it != last; ++it) {
+            const size_t next = static_cast<size_t>(*it);
+            std::move(buffer_ + read, buffer_ + next, buffer_ + out);
+            out += next - read;
+            read = next + 1;
+        }
+        std::move(buffer_ + read, buffer_ + size_, buffer_ + out);
+        out += size_ - read;
+
+        stats_.on_shift(out - static_cast<size_t>(*std::ranges::begin(indices)));
+        destroy_tail(out);
+        return old_size - size_;
+    }
+
+    constexpr void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    constexpr void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    constexpr void pop_back() {
+        CheckPolicy::template require<std::runtime_error>(size_ != 0, "Cannot pop from empty vector");
+        Traits::destroy(&buffer_[size_ - 1], allocator_);
+        --size_;
+    }
+
+    constexpr T& back() {
+        CheckPolicy::template require<std::runtime_error>(size_ != 0, "Vector is empty");
+        return buffer_[size_ - 1];
+    }
+
+    constexpr const T& back() const {
+        CheckPolicy::template require<std::runtime_error>(size_ != 0, "Vector is empty");
+        return buffer_[size_ - 1];
+    }
+
+    constexpr T& front() {
+        CheckPolicy::template require<std::runtime_error>(size_ != 0, "Vector is empty");
+        return buffer_[0];
+    }
+
+    constexpr const T& front() const {
+        CheckPolicy::template require<std::runtime_error>(size_ != 0, "Vector is empty");
+        return buffer_[0];
+    }
+};
+
+// Small-buffer Vector: up to N elements are stored inline, larger sizes spill to the allocator
+template <class T, size_t N, class Allocator = DefaultAllocator<T>, class GrowthPolicy = DoublingGrowth,
+          class StatsPolicy = DefaultStatsPolicy, class CheckPolicy = DefaultCheckPolicy>
+using SmallVector = Vector<T, Allocator, N, GrowthPolicy, StatsPolicy, CheckPolicy>;
+
+// Raw pointer iterators make Vector a contiguous range, which std::ranges algorithms, std::span
+// and CompareHelper rely on for their memmove and vectorized paths
+static_assert(std::ranges::contiguous_range<Vector<int>> && std::ranges::sized_range<Vector<int>>);
+static_assert(std::ranges::contiguous_range<const Vector<int>> && std::ranges::sized_range<const Vector<int>>);
+
+// Uniform container erasure, as std::erase and std::erase_if provide for std::vector
+template <typename T, typename Allocator, size_t N, typename... Policies, typename U>
+constexpr size_t erase(Vector<T, Allocator, N, Policies...>& v, const U& value) {
+    return v.remove_if([&value](const T& element) { return element == value; });
+}
+
+template <typename T, typename Allocator, size_t N, typename... Policies, typename Pred>
+constexpr size_t erase_if(Vector<T, Allocator, N, Policies...>& v, Pred pred) {
+    return v.remove_if(pred);
+}
+
+// Transform a range to container. Containers with append_range (such as Vector) measure sized
+// and forward ranges once and fill a single allocation; others get a reserve() when they have one.
+template <typename Container, std::ranges::input_range Range, typename... Args>
+constexpr Container to(Range&& range, Args&&... args) {
+    Container container(std::forward<Args>(args)...);
+    if constexpr (requires { container.append_range(range); }) {
+        container.append_range(range);
+    } else {
+        if constexpr ((std::ranges::sized_range<Range> || std::ranges::forward_range<Range>) &&
+                      requires { container.reserve(size_t{}); }) {
+            container.reserve(static_cast<size_t>(std::ranges::distance(range)));
+        }
+        for (auto&& element : range)
+            container.emplace_back(std::forward<decltype(element)>(element));
+    }
+    return container;
+}
+
+// Basic range adapter for vector
+namespace vector_adapters {
+    template <std::ranges::range R, typename T = std::ranges::range_value_t<R>>
+    auto to_vector(R&& r) -> Vector<T> {
+        return to<Vector<T>>(std::forward<R>(r));
+    }
+
+    // Sized and forward ranges are measured first and each result is constructed directly in
+    // the vector's uninitialized storage, without an intermediate temporary
+    template <std::ranges::range R, typename Func>
+    auto transform_to_vector(R&& r, Func&& func) {
+        using T = std::remove_cvref_t<std::invoke_result_t<Func&, std::ranges::range_reference_t<R>>>;
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            const size_t count = static_cast<size_t>(std::ranges::distance(r));
+            Vector<T> result;
+            T* out = result.append_uninitialized(count);
+            size_t i = 0;
+            try {
+                for (auto&& element : r) {
+                    ::new (static_cast<void*>(out + i)) T(std::invoke(func, std::forward<decltype(element)>(element)));
+                    ++i;
+                }
+            } catch (...) {
+                while (i > 0) {
+                    out[--i].~T();
+                }
+                throw;
+            }
+            result.commit_append(count);
+            return result;
+        } else {
+            auto transformed = r | std::views::transform(std::forward<Func>(func));
+            return to<Vector<T>>(transformed);
+        }
+    }
+
+    // Parallel variant for sized random-access ranges; func is called concurrently from several
+    // threads, each constructing its own chunk of the result
+    template <std::ranges::random_access_range R, typename Func>
+        requires std::ranges::sized_range<R>
+    auto transform_to_vector(ParallelTag policy, R&& r, Func&& func) {
+        using T = std::remove_cvref_t<std::invoke_result_t<Func&, std::ranges::range_reference_t<R>>>;
+        using Difference = std::ranges::range_difference_t<R>;
+        const size_t count = static_cast<size_t>(std::ranges::size(r));
+        Vector<T> result;
+        T* out = result.append_uninitialized(count);
+        auto first = std::ranges::begin(r);
+        ParallelHelper::for_each_chunk(policy, count, sizeof(T),
+            [&](size_t begin, size_t end) {
+                size_t i = begin;
+                try {
+                    for (; i < end; ++i) {
+                        ::new (static_cast<void*>(out + i)) T(std::invoke(func, first[static_cast<Difference>(i)]));
+                    }
+                } catch (...) {
+                    while (i > begin) {
+                        out[--i].~T();
+                    }
+                    throw;
+                }
+            },
+            [out](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    out[i].~T();
+                }
+            });
+        result.commit_append(count);
+        return result;
+    }
+
+    // Run build() - a constexpr callable returning a Vector - at compile time and keep the result
+    // as a std::array, since a Vector's storage cannot outlive constant evaluation:
+    //
+    //   constexpr auto crc_table = vector_adapters::to_array<[] {
+    //       Vector<uint32_t> table;
+    //       for (uint32_t i = 0; i < 256; ++i) table.push_back(crc_entry(i));
+    //       return table;
+    //   }>();
+    template <auto Build>
+    consteval auto to_array() {
+        using Result = decltype(Build());
+        std::array<typename Result::ValueType, Build().size()> result{};
+        const Result built = Build();
+        std::copy(built.begin(), built.end(), result.begin());
+        return result;
+    }
+
+    // Counting the survivors first would run the predicate twice per element, so this one
+    // grows as it goes instead of pre-sizing
+    template <std::ranges::range R, typename Pred>
+    auto filter_to_vector(R&& r, Pred&& pred) {
+        auto filtered = r | std::views::filter(std::forward<Pred>(pred));
+        using T = std::ranges::range_value_t<decltype(filtered)>;
+        Vector<T> result;
+        for (auto&& element : filtered)
+            result.emplace_back(std::forward<decltype(element)>(element));
+        return result;
+    }
+
+    template <std::ranges::range R>
+    auto take_to_vector(R&& r, std::size_t count) {
+        auto taken = r | std::views::take(count);
+        using T = std::ranges::range_value_t<decltype(taken)>;
+        return to<Vector<T>>(taken);
+    }
+
+    template <std::ranges::range R>
+    auto drop_to_vector(R&& r, std::size_t count) {
+        auto dropped = r | std::views::drop(count);
+        using T = std::ranges::range_value_t<decltype(dropped)>;
+        return to<Vector<T>>(dropped);
+    }
+
+    template <std::ranges::bidirectional_range R>
+    auto reverse_to_vector(R&& r) {
+        auto reversed = r | std::views::reverse;
+        using T = std::ranges::range_value_t<decltype(reversed)>;
+        return to<Vector<T>>(reversed);
+    }
+
+    // The remaining adapters need C++23 views
+#if defined(__cpp_lib_ranges_zip)
+    template <std::ranges::range R1, std::ranges::range R2>
+    auto zip_to_vector(R1&& r1, R2&& r2) {
+        auto zipped = std::views::zip(r1, r2);
+        using T = std::ranges::range_value_t<decltype(zipped)>;
+        return to<Vector<T>>(zipped);
+    }
+#endif
+
+#if defined(__cpp_lib_ranges_chunk)
+    template <std::ranges::range R>
+    auto chunk_to_vector(R&& r, std::size_t chunk_size) {
+        auto chunked = std::views::chunk(r, chunk_size);
+        using T = std::ranges::range_value_t<decltype(chunked)>;
+        return to<Vector<T>>(chunked);
+    }
+#endif
+
+#if defined(__cpp_lib_ranges_enumerate)
+    template <std::ranges::range R>
+    auto enumerate_to_vector(R&& r) {
+        auto enumerated = std::views::enumerate(r);
+        using T = std::ranges::range_value_t<decltype(enumerated)>;
+        return to<Vector<T>>(enumerated);
+    }
+#endif
+}
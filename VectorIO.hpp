@@ -0,0 +1,381 @@
+#pragma once
+
+#include "Vector.hpp"
+
+#include <cerrno>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Binary Serialization
+// write_to/read_from store a Vector as a small header followed by its elements, to a file
+// descriptor or to a std::ostream/std::istream. Trivially copyable elements are written as the raw
+// data() block (one writev together with the header) and read straight into the vector's storage;
+// everything else goes element by element through vector_io::Serializer<T>, which covers
+// std::string and nested Vectors and can be specialized for other types:
+//
+//   template <> struct vector_io::Serializer<Point> {
+//       template <typename Sink> static void write(Sink& out, const Point& p) { ... }
+//       template <typename Source> static Point read(Source& in) { ... }
+//   };
+//
+// The format is native-endian and meant for snapshots read back on the same platform.
+namespace vector_io {
+    struct StreamHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t element_size;
+        uint32_t flags;
+        uint64_t count;
+    };
+
+    inline constexpr uint32_t stream_magic = 0x53434556;  // "VECS"
+    inline constexpr uint32_t stream_version = 1;
+    inline constexpr uint32_t raw_elements = 1;  // flag: elements follow as one data() block
+
+    // Buffer size of the descriptor sinks and sources, and the unit in which raw elements of
+    // unknown total size are appended
+    inline constexpr size_t chunk_bytes = size_t(1) << 16;
+    inline constexpr size_t raw_chunk_bytes = size_t(16) << 20;
+
+    [[noreturn]] inline void fail_system(const char* what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    [[noreturn]] inline void fail_format(const char* what) {
+        throw std::runtime_error(std::string("Vector stream: ") + what);
+    }
+
+    // Write all of iov[0, count), resuming after partial writes and signals
+    inline void write_fully(const int fd, iovec* iov, int count) {
+        while (count > 0) {
+            const ssize_t written = ::writev(fd, iov, count);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                fail_system("Vector stream: write failed");
+            }
+            size_t left = static_cast<size_t>(written);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    // Byte Sinks and Sources
+    // Sinks provide write(data, bytes); sources provide read(data, bytes), which throws on a
+    // short read, and can_hold(bytes), which is true only when that many bytes are known to follow.
+    class FdSink {
+    public:
+        explicit FdSink(const int fd) : fd_(fd), used_(0) {}
+
+        FdSink(const FdSink&) = delete;
+        FdSink& operator=(const FdSink&) = delete;
+
+        void write(const void* data, const size_t bytes) {
+            if (bytes > chunk_bytes - used_) {
+                // Send what is buffered and, if it is large, the new block with it in one call
+                iovec iov[2] = {{buffer_, used_}, {const_cast<void*>(data), bytes}};
+                if (bytes >= chunk_bytes) {
+                    write_fully(fd_, iov, 2);
+                    used_ = 0;
+                    return;
+                }
+                write_fully(fd_, iov, 1);
+                used_ = 0;
+            }
+            std::memcpy(buffer_ + used_, data, bytes);
+            used_ += bytes;
+        }
+
+        void flush() {
+            iovec iov = {buffer_, used_};
+            write_fully(fd_, &iov, 1);
+            used_ = 0;
+        }
+
+    private:
+        int fd_;
+        size_t used_;
+        unsigned char buffer_[chunk_bytes];
+    };
+
+    class FdSource {
+    public:
+        explicit FdSource(const int fd) : fd_(fd), begin_(0), end_(0) {}
+
+        // Hand read-ahead back to a seekable descriptor, so whatever follows in the file can be
+        // read next; on pipes and sockets the read-ahead is lost
+        ~FdSource() {
+            if (end_ > begin_) {
+                ::lseek(fd_, -static_cast<off_t>(end_ - begin_), SEEK_CUR);
+            }
+        }
+
+        FdSource(const FdSource&) = delete;
+        FdSource& operator=(const FdSource&) = delete;
+
+        void read(void* data, size_t bytes) {
+            auto* out = static_cast<unsigned char*>(data);
+            const size_t buffered = std::min(bytes, end_ - begin_);
+            std::memcpy(out, buffer_ + begin_, buffered);
+            begin_ += buffered;
+            out += buffered;
+            bytes -= buffered;
+            if (bytes == 0) return;
+
+            if (bytes >= chunk_bytes) {
+                // Large blocks go straight to their destination
+                read_fully(out, bytes);
+                return;
+            }
+            begin_ = 0;
+            end_ = read_some(buffer_, chunk_bytes);
+            while (end_ < bytes) {
+                const size_t got = read_some(buffer_ + end_, chunk_bytes - end_);
+                if (got == 0) fail_format("unexpected end of input");
+                end_ += got;
+            }
+            std::memcpy(out, buffer_, bytes);
+            begin_ = bytes;
+        }
+
+        bool can_hold(const size_t bytes) const {
+            struct stat info;
+            if (::fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode)) return false;
+            const off_t position = ::lseek(fd_, 0, SEEK_CUR);
+            if (position < 0 || position > info.st_size) return false;
+            return bytes <= static_cast<size_t>(info.st_size - position) + (end_ - begin_);
+        }
+
+    private:
+        size_t read_some(void* data, const size_t bytes) {
+            for (;;) {
+                const ssize_t got = ::read(fd_, data, bytes);
+                if (got >= 0) return static_cast<size_t>(got);
+                if (errno != EINTR) fail_system("Vector stream: read failed");
+            }
+        }
+
+        void read_fully(unsigned char* out, size_t bytes) {
+            while (bytes > 0) {
+                const size_t got = read_some(out, bytes);
+                if (got == 0) fail_format("unexpected end of input");
+                out += got;
+                bytes -= got;
+            }
+        }
+
+        int fd_;
+        size_t begin_;
+        size_t end_;
+        unsigned char buffer_[chunk_bytes];
+    };
+
+    class StreamSink {
+    public:
+        explicit StreamSink(std::ostream& out) : out_(out) {}
+
+        void write(const void* data, const size_t bytes) {
+            if (!out_.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes))) {
+                fail_format("write failed");
+            }
+        }
+
+        void flush() {
+            if (!out_.flush()) fail_format("write failed");
+        }
+
+    private:
+        std::ostream& out_;
+    };
+
+    class StreamSource {
+    public:
+        explicit StreamSource(std::istream& in) : in_(in) {}
+
+        void read(void* data, const size_t bytes) {
+            if (!in_.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))) {
+                fail_format("unexpected end of input");
+            }
+        }
+
+        bool can_hold(const size_t) const { return false; }
+
+    private:
+        std::istream& in_;
+    };
+
+    // Serialization Customization Point
+    template <typename T>
+    struct Serializer;
+
+    template <typename T>
+        requires std::is_trivially_copyable_v<T>
+    struct Serializer<T> {
+        template <typename Sink>
+        static void write(Sink& out, const T& value) { out.write(&value, sizeof(T)); }
+
+        template <typename Source>
+        static T read(Source& in) {
+            unsigned char bytes[sizeof(T)];
+            in.read(bytes, sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+    };
+
+    template <>
+    struct Serializer<std::string> {
+        template <typename Sink>
+        static void write(Sink& out, const std::string& value) {
+            const uint64_t length = value.size();
+            out.write(&length, sizeof(length));
+            out.write(value.data(), value.size());
+        }
+
+        template <typename Source>
+        static std::string read(Source& in) {
+            uint64_t length;
+            in.read(&length, sizeof(length));
+            std::string value;
+            // Grow as the bytes arrive, so a corrupt length cannot reserve unbounded memory
+            while (value.size() < length) {
+                const size_t offset = value.size();
+                value.resize(offset + std::min<uint64_t>(length - offset, chunk_bytes));
+                in.read(value.data() + offset, value.size() - offset);
+            }
+            return value;
+        }
+    };
+
+    template <typename T>
+    concept RawSerializable = std::is_trivially_copyable_v<T>;
+
+    // Element data after the header, shared by the top-level format and nested vectors
+    template <typename Sink, typename T, typename Allocator, size_t N, typename... Policies>
+    void write_elements(Sink& out, const Vector<T, Allocator, N, Policies...>& v) {
+        if constexpr (RawSerializable<T>) {
+            if (!v.empty()) out.write(v.data(), v.size() * sizeof(T));
+        } else {
+            for (const T& element : v) {
+                Serializer<T>::write(out, element);
+            }
+        }
+    }
+
+    // Append count elements; raw blocks are read straight into the vector's spare capacity
+    template <typename Source, typename T, typename Allocator, size_t N, typename... Policies>
+    void read_elements(Source& in, Vector<T, Allocator, N, Policies...>& v, const uint64_t count) {
+        const size_t old_size = v.size();
+        try {
+            if constexpr (RawSerializable<T>) {
+                if (count > (static_cast<size_t>(-1) - old_size) / sizeof(T)) fail_format("element count too large");
+                if (in.can_hold(count * sizeof(T))) {
+                    v.reserve(old_size + count);
+                }
+                // Otherwise the elements arrive in bounded chunks, so the vector never reserves
+                // more than the input really holds
+                const size_t chunk = std::max<size_t>(1, raw_chunk_bytes / sizeof(T));
+                for (uint64_t left = count; left > 0;) {
+                    const size_t n = static_cast<size_t>(std::min<uint64_t>(left, chunk));
+                    T* out = v.append_uninitialized(n);
+                    in.read(out, n * sizeof(T));
+                    v.commit_append(n);
+                    left -= n;
+                }
+            } else {
+                for (uint64_t i = 0; i < count; ++i) {
+                    v.emplace_back(Serializer<T>::read(in));
+                }
+            }
+        } catch (...) {
+            v.erase(v.begin() + old_size, v.end());
+            throw;
+        }
+    }
+
+    template <typename T, typename Allocator, size_t N, typename... Policies>
+    struct Serializer<Vector<T, Allocator, N, Policies...>> {
+        template <typename Sink>
+        static void write(Sink& out, const Vector<T, Allocator, N, Policies...>& value) {
+            const uint64_t count = value.size();
+            out.write(&count, sizeof(count));
+            write_elements(out, value);
+        }
+
+        template <typename Source>
+        static Vector<T, Allocator, N, Policies...> read(Source& in) {
+            uint64_t count;
+            in.read(&count, sizeof(count));
+            Vector<T, Allocator, N, Policies...> value;
+            read_elements(in, value, count);
+            return value;
+        }
+    };
+
+    template <typename T>
+    StreamHeader make_header(const size_t count) noexcept {
+        return StreamHeader{stream_magic, stream_version, static_cast<uint32_t>(sizeof(T)),
+                            RawSerializable<T> ? raw_elements : 0u, count};
+    }
+
+    template <typename T, typename Source>
+    uint64_t read_header(Source& in) {
+        StreamHeader header;
+        in.read(&header, sizeof(header));
+        if (header.magic != stream_magic || header.version != stream_version) {
+            fail_format("not a serialized vector");
+        }
+        if ((header.flags & raw_elements) != (RawSerializable<T> ? raw_elements : 0u) || header.element_size != sizeof(T)) {
+            fail_format("stream holds a different element type");
+        }
+        return header.count;
+    }
+
+    // Writes v to fd; trivially copyable elements go out with the header in a single writev
+    template <typename T, typename Allocator, size_t N, typename... Policies>
+    void write_to(const int fd, const Vector<T, Allocator, N, Policies...>& v) {
+        StreamHeader header = make_header<T>(v.size());
+        if constexpr (RawSerializable<T>) {
+            iovec iov[2] = {{&header, sizeof(header)}, {const_cast<T*>(v.data()), v.size() * sizeof(T)}};
+            write_fully(fd, iov, v.empty() ? 1 : 2);
+        } else {
+            FdSink out(fd);
+            out.write(&header, sizeof(header));
+            write_elements(out, v);
+            out.flush();
+        }
+    }
+
+    template <typename T, typename Allocator, size_t N, typename... Policies>
+    void write_to(std::ostream& os, const Vector<T, Allocator, N, Policies...>& v) {
+        StreamSink out(os);
+        const StreamHeader header = make_header<T>(v.size());
+        out.write(&header, sizeof(header));
+        write_elements(out, v);
+        out.flush();
+    }
+
+    // Appends the serialized elements to v; on error v keeps its previous contents
+    template <typename T, typename Allocator, size_t N, typename... Policies>
+    void read_from(const int fd, Vector<T, Allocator, N, Policies...>& v) {
+        FdSource in(fd);
+        read_elements(in, v, read_header<T>(in));
+    }
+
+    template <typename T, typename Allocator, size_t N, typename... Policies>
+    void read_from(std::istream& is, Vector<T, Allocator, N, Policies...>& v) {
+        StreamSource in(is);
+        read_elements(in, v, read_header<T>(in));
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Vector Statistics
+// Counting StatsPolicy for Vector. Every vector keeps its own counters and, when destroyed, adds
+// them to VectorStatsRegistry under its tag, so the registry shows which call sites churn:
+//
+//   Vector<Row, DefaultAllocator<Row>, 0, DoublingGrowth, VectorStats> rows;
+//   rows.stats().tag();           // tagged with this file:line
+//   ...
+//   VectorStatsRegistry::instance().dump(std::cerr);
+//
+// Build with -DVECTOR_ENABLE_STATS to make this the policy of every Vector. The counters are plain
+// integers: a vector is as thread-safe with statistics as without. VectorStats is a literal type,
+// so constexpr vectors keep compiling; vectors that live only during constant evaluation count
+// but are never added to the registry.
+class VectorStats {
+public:
+    struct Counters {
+        size_t vectors = 0;              // vectors folded into these counters
+        size_t allocations = 0;          // heap blocks obtained
+        size_t reallocations = 0;        // times the contents moved to a new block
+        size_t relocated_bytes = 0;      // bytes copied by those moves
+        size_t peak_capacity_bytes = 0;  // largest capacity reached by one vector
+        size_t wasted_bytes = 0;         // capacity minus size when the vectors died
+        size_t shifted_elements = 0;     // elements moved by insertion and erasure in the middle
+
+        constexpr void merge(const Counters& other) noexcept {
+            vectors += other.vectors;
+            allocations += other.allocations;
+            reallocations += other.reallocations;
+            relocated_bytes += other.relocated_bytes;
+            peak_capacity_bytes = std::max(peak_capacity_bytes, other.peak_capacity_bytes);
+            wasted_bytes += other.wasted_bytes;
+            shifted_elements += other.shifted_elements;
+        }
+    };
+
+private:
+    Counters counters_;
+    const char* tag_ = nullptr;
+    unsigned line_ = 0;  // non-zero when the tag is a file name
+
+    void flush() noexcept;
+
+public:
+    constexpr VectorStats() noexcept = default;
+
+    // Counters belong to one object: a copy starts from zero under the same tag
+    constexpr VectorStats(const VectorStats& other) noexcept : tag_(other.tag_), line_(other.line_) {}
+    constexpr VectorStats& operator=(const VectorStats&) noexcept { return *this; }
+
+    // A vector that lived only during constant evaluation has nowhere to report to
+    constexpr ~VectorStats() {
+        if (!std::is_constant_evaluated()) flush();
+    }
+
+    constexpr void on_allocate(size_t) noexcept { ++counters_.allocations; }
+
+    constexpr void on_reallocate(const size_t bytes) noexcept {
+        ++counters_.reallocations;
+        counters_.relocated_bytes += bytes;
+    }
+
+    constexpr void on_capacity(const size_t bytes) noexcept {
+        counters_.peak_capacity_bytes = std::max(counters_.peak_capacity_bytes, bytes);
+    }
+
+    constexpr void on_shift(const size_t elements) noexcept { counters_.shifted_elements += elements; }
+
+    constexpr void on_destroy(const size_t size_bytes, const size_t capacity_bytes) noexcept {
+        counters_.wasted_bytes += capacity_bytes - size_bytes;
+    }
+
+    // Tags must outlive the program's last dump; string literals and source locations do
+    constexpr void tag(const char* name) noexcept {
+        tag_ = name;
+        line_ = 0;
+    }
+
+    constexpr void tag(const std::source_location where = std::source_location::current()) noexcept {
+        tag_ = where.file_name();
+        line_ = where.line();
+    }
+
+    std::string name() const {
+        if (!tag_) return "(untagged)";
+        return line_ ? std::string(tag_) + ":" + std::to_string(line_) : std::string(tag_);
+    }
+
+    constexpr const Counters& counters() const noexcept { return counters_; }
+};
+
+// Process-wide totals per tag, filled in as instrumented vectors are destroyed
+class VectorStatsRegistry {
+    mutable std::mutex mutex_;
+    std::map<std::string, VectorStats::Counters> totals_;
+
+    VectorStatsRegistry() = default;
+
+public:
+    // Never destroyed, so vectors with static storage can still report at exit
+    static VectorStatsRegistry& instance() {
+        static VectorStatsRegistry* registry = new VectorStatsRegistry();
+        return *registry;
+    }
+
+    void record(const std::string& tag, const VectorStats::Counters& counters) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        totals_[tag].merge(counters);
+    }
+
+    std::vector<std::pair<std::string, VectorStats::Counters>> snapshot() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return {totals_.begin(), totals_.end()};
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        totals_.clear();
+    }
+
+    // One tab-separated line per tag, after a header line
+    void dump(std::ostream& os) const {
+        os << "tag\tvectors\tallocations\treallocations\trelocated_bytes\tpeak_capacity_bytes\twasted_bytes\tshifted_elements\n";
+        for (const auto& [tag, c] : snapshot()) {
+            os << tag << '\t' << c.vectors << '\t' << c.allocations << '\t' << c.reallocations << '\t'
+               << c.relocated_bytes << '\t' << c.peak_capacity_bytes << '\t' << c.wasted_bytes << '\t'
+               << c.shifted_elements << '\n';
+        }
+    }
+};
+
+// Vectors that never allocated or shifted are left out, so short-lived empties cost no lock
+inline void VectorStats::flush() noexcept {
+    if (counters_.allocations == 0 && counters_.shifted_elements == 0) return;
+    counters_.vectors = 1;
+    try {
+        VectorStatsRegistry::instance().record(name(), counters_);
+    } catch (...) {
+        // Statistics are best effort; never let them take the program down
+    }
+}
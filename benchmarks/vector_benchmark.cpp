@@ -0,0 +1,749 @@
+// Google Benchmark suite comparing Vector against std::vector (and the sibling containers where
+// they apply).
+//
+// Build from the repository root:
+//   g++ -std=c++20 -O2 -I. benchmarks/vector_benchmark.cpp -lbenchmark -lpthread -o vector_benchmark
+// Export results for dashboards:
+//   ./vector_benchmark --benchmark_format=json --benchmark_out=results.json
+
+#include "Vector.hpp"
+#include "BitVector.hpp"
+#include "ConcurrentVector.hpp"
+#include "FlatMap.hpp"
+#include "FrozenVector.hpp"
+#include "SegmentedVector.hpp"
+#include "SoAVector.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Element Types
+struct Pod64 {
+    std::uint64_t words[8];
+};
+
+// Copyable and movable, but not trivially, so every relocation runs user code
+struct NonTrivialMove {
+    std::uint64_t value;
+
+    NonTrivialMove(std::uint64_t v = 0) noexcept : value(v) {}
+    NonTrivialMove(const NonTrivialMove& other) noexcept : value(other.value) {}
+    NonTrivialMove(NonTrivialMove&& other) noexcept : value(other.value) { other.value = 0; }
+    NonTrivialMove& operator=(const NonTrivialMove& other) noexcept {
+        value = other.value;
+        return *this;
+    }
+    NonTrivialMove& operator=(NonTrivialMove&& other) noexcept {
+        value = other.value;
+        other.value = 0;
+        return *this;
+    }
+    ~NonTrivialMove() {}
+};
+
+template <typename T>
+T make_value(const size_t i) {
+    if constexpr (std::is_same_v<T, int>) {
+        return static_cast<int>(i);
+    } else if constexpr (std::is_same_v<T, Pod64>) {
+        return Pod64{{i, i, i, i, i, i, i, i}};
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        // Long enough to defeat the small-string optimization
+        return std::string(32, static_cast<char>('a' + i % 26));
+    } else {
+        return T(i);
+    }
+}
+
+// Vector and std::vector differ slightly in naming; these keep the benchmark bodies shared
+template <typename Container>
+struct ContainerValueType {
+    using Type = typename Container::value_type;
+};
+
+template <typename T, typename Allocator, size_t FirstSegment>
+struct ContainerValueType<SegmentedVector<T, Allocator, FirstSegment>> {
+    using Type = T;
+};
+
+template <typename Container>
+using ValueOf = typename ContainerValueType<Container>::Type;
+
+template <typename Container>
+Container make_filled(const size_t n) {
+    using T = ValueOf<Container>;
+    Container c;
+    c.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        c.push_back(make_value<T>(i));
+    }
+    return c;
+}
+
+// Sizes from 1 upwards in powers of ten, capped at 1e8 elements or about 400 MB per vector
+template <typename T>
+void element_sizes(benchmark::internal::Benchmark* b) {
+    constexpr int64_t max_bytes = int64_t(400) * 1024 * 1024;
+    constexpr int64_t max_elements = std::min<int64_t>(100'000'000, max_bytes / sizeof(T));
+    b->RangeMultiplier(10)->Range(1, max_elements);
+}
+
+template <typename Container, typename Range>
+void append(Container& c, const Range& r) {
+    if constexpr (requires { c.append_range(r); })
+        c.append_range(r);
+    else
+        c.insert(c.end(), std::ranges::begin(r), std::ranges::end(r));
+}
+
+template <typename Container>
+void set_items(benchmark::State& state) {
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(ValueOf<Container>));
+}
+
+// Growth
+template <typename Container>
+void BM_PushBack(benchmark::State& state) {
+    using T = ValueOf<Container>;
+    const size_t n = state.range(0);
+    const T value = make_value<T>(7);
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < n; ++i) {
+            c.push_back(value);
+        }
+        benchmark::DoNotOptimize(c);
+    }
+    set_items<Container>(state);
+}
+
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state) {
+    using T = ValueOf<Container>;
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < n; ++i) {
+            c.emplace_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+template <typename Container>
+void BM_ReserveThenPushBack(benchmark::State& state) {
+    using T = ValueOf<Container>;
+    const size_t n = state.range(0);
+    const T value = make_value<T>(7);
+    for (auto _ : state) {
+        Container c;
+        c.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            c.push_back(value);
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+// A single reserve that has to relocate n existing elements
+template <typename Container>
+void BM_ReserveRelocate(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = make_filled<Container>(n);
+        state.ResumeTiming();
+        c.reserve(2 * n);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+// Copy and Move
+template <typename Container>
+void BM_Copy(benchmark::State& state) {
+    const Container source = make_filled<Container>(state.range(0));
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    set_items<Container>(state);
+}
+
+// Copy assignment into a vector that already holds as many elements
+template <typename Container>
+void BM_CopyAssign(benchmark::State& state) {
+    const Container source = make_filled<Container>(state.range(0));
+    Container target = make_filled<Container>(state.range(0));
+    for (auto _ : state) {
+        target = source;
+        benchmark::DoNotOptimize(target.data());
+    }
+    set_items<Container>(state);
+}
+
+template <typename Container>
+void BM_Move(benchmark::State& state) {
+    Container source = make_filled<Container>(state.range(0));
+    for (auto _ : state) {
+        Container moved(std::move(source));
+        benchmark::DoNotOptimize(moved.data());
+        source = std::move(moved);
+    }
+}
+
+// Insertion and Erasure
+template <typename Container>
+void BM_MidInsert(benchmark::State& state) {
+    using T = ValueOf<Container>;
+    Container c = make_filled<Container>(state.range(0));
+    const T value = make_value<T>(7);
+    for (auto _ : state) {
+        c.insert(c.begin() + c.size() / 2, value);
+        c.erase(c.begin() + c.size() / 2);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+// Erase the middle half of the vector
+template <typename Container>
+void BM_RangeErase(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container c = make_filled<Container>(n);
+        state.ResumeTiming();
+        c.erase(c.begin() + n / 4, c.begin() + n / 4 + n / 2);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+template <typename Container>
+void BM_AppendRange(benchmark::State& state) {
+    using T = ValueOf<Container>;
+    const std::vector<T> source = make_filled<std::vector<T>>(state.range(0));
+    for (auto _ : state) {
+        Container c;
+        append(c, source);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+#define VECTOR_BENCHMARK(fn, T)                                                   \
+    BENCHMARK_TEMPLATE(fn, Vector<T>)->Apply(element_sizes<T>);                  \
+    BENCHMARK_TEMPLATE(fn, std::vector<T>)->Apply(element_sizes<T>)
+
+#define VECTOR_BENCHMARK_ALL_TYPES(fn)                                            \
+    VECTOR_BENCHMARK(fn, int);                                                    \
+    VECTOR_BENCHMARK(fn, Pod64);                                                  \
+    VECTOR_BENCHMARK(fn, std::string);                                            \
+    VECTOR_BENCHMARK(fn, NonTrivialMove)
+
+VECTOR_BENCHMARK_ALL_TYPES(BM_PushBack);
+VECTOR_BENCHMARK_ALL_TYPES(BM_EmplaceBack);
+VECTOR_BENCHMARK_ALL_TYPES(BM_ReserveThenPushBack);
+VECTOR_BENCHMARK_ALL_TYPES(BM_ReserveRelocate);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Copy);
+VECTOR_BENCHMARK_ALL_TYPES(BM_CopyAssign);
+VECTOR_BENCHMARK_ALL_TYPES(BM_Move);
+VECTOR_BENCHMARK_ALL_TYPES(BM_MidInsert);
+VECTOR_BENCHMARK_ALL_TYPES(BM_RangeErase);
+VECTOR_BENCHMARK_ALL_TYPES(BM_AppendRange);
+
+// Segmented vectors grow without relocating anything
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedVector<int>)->Apply(element_sizes<int>);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedVector<std::string>)->Apply(element_sizes<std::string>);
+BENCHMARK_TEMPLATE(BM_PushBack, SegmentedVector<NonTrivialMove>)->Apply(element_sizes<NonTrivialMove>);
+
+// Many threads appending to one vector: lock-free slot claiming against a mutex
+void BM_ConcurrentPushBack(benchmark::State& state) {
+    static ConcurrentVector<int>* shared = nullptr;
+    if (state.thread_index() == 0) shared = new ConcurrentVector<int>();
+    for (auto _ : state) {
+        shared->push_back(static_cast<int>(state.iterations()));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) delete shared;
+}
+
+void BM_MutexPushBack(benchmark::State& state) {
+    static Vector<int>* shared = nullptr;
+    static std::mutex mutex;
+    if (state.thread_index() == 0) shared = new Vector<int>();
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(mutex);
+        shared->push_back(static_cast<int>(state.iterations()));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) delete shared;
+}
+
+BENCHMARK(BM_ConcurrentPushBack)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK(BM_MutexPushBack)->ThreadRange(1, 32)->UseRealTime();
+
+// Small vectors: inline storage against heap allocation
+template <typename Container>
+void BM_SmallPushBack(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        Container c;
+        for (size_t i = 0; i < n; ++i) {
+            c.push_back(static_cast<int>(i));
+        }
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Container>(state);
+}
+
+BENCHMARK_TEMPLATE(BM_SmallPushBack, SmallVector<int, 8>)->DenseRange(1, 8);
+BENCHMARK_TEMPLATE(BM_SmallPushBack, Vector<int>)->DenseRange(1, 8);
+BENCHMARK_TEMPLATE(BM_SmallPushBack, std::vector<int>)->DenseRange(1, 8);
+
+// Large vectors: mmap-backed buffers grow by remapping pages instead of copying them
+#if defined(__linux__)
+using MmapVector = Vector<std::uint64_t, MmapAllocator<std::uint64_t>>;
+
+BENCHMARK_TEMPLATE(BM_PushBack, MmapVector)->Apply(element_sizes<std::uint64_t>);
+BENCHMARK_TEMPLATE(BM_PushBack, Vector<std::uint64_t>)->Apply(element_sizes<std::uint64_t>);
+BENCHMARK_TEMPLATE(BM_ReserveRelocate, MmapVector)->Apply(element_sizes<std::uint64_t>);
+BENCHMARK_TEMPLATE(BM_ReserveRelocate, Vector<std::uint64_t>)->Apply(element_sizes<std::uint64_t>);
+#endif
+
+// Comparison of two equal vectors, the worst case for both operators
+template <typename Container>
+void BM_Equal(benchmark::State& state) {
+    const Container a = make_filled<Container>(state.range(0));
+    const Container b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a == b);
+    }
+    set_items<Container>(state);
+}
+
+template <typename Container>
+void BM_ThreeWay(benchmark::State& state) {
+    const Container a = make_filled<Container>(state.range(0));
+    const Container b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a <=> b);
+    }
+    set_items<Container>(state);
+}
+
+VECTOR_BENCHMARK(BM_Equal, std::uint8_t);
+VECTOR_BENCHMARK(BM_Equal, int);
+VECTOR_BENCHMARK(BM_Equal, float);
+VECTOR_BENCHMARK(BM_ThreeWay, std::uint8_t);
+VECTOR_BENCHMARK(BM_ThreeWay, int);
+VECTOR_BENCHMARK(BM_ThreeWay, float);
+
+// Parallel bulk operations against their serial counterparts, on vectors large enough to split
+void BM_Fill(benchmark::State& state) {
+    for (auto _ : state) {
+        Vector<int> v(state.range(0), 7);
+        benchmark::DoNotOptimize(v.data());
+    }
+    set_items<Vector<int>>(state);
+}
+
+void BM_ParallelFill(benchmark::State& state) {
+    for (auto _ : state) {
+        Vector<int> v(parallel, state.range(0), 7);
+        benchmark::DoNotOptimize(v.data());
+    }
+    set_items<Vector<int>>(state);
+}
+
+void BM_ParallelCopy(benchmark::State& state) {
+    const auto source = make_filled<Vector<int>>(state.range(0));
+    for (auto _ : state) {
+        Vector<int> copy(parallel, source);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    set_items<Vector<int>>(state);
+}
+
+void BM_ParallelReserveRelocate(benchmark::State& state) {
+    const size_t n = state.range(0);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto c = make_filled<Vector<int>>(n);
+        state.ResumeTiming();
+        c.reserve(parallel, 2 * n);
+        benchmark::DoNotOptimize(c.data());
+    }
+    set_items<Vector<int>>(state);
+}
+
+BENCHMARK(BM_Fill)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelFill)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Copy, Vector<int>)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelCopy)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ReserveRelocate, Vector<int>)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+BENCHMARK(BM_ParallelReserveRelocate)->RangeMultiplier(10)->Range(100'000, 100'000'000)->UseRealTime();
+
+// Structure of arrays: scanning one field of a wide record
+struct Particle {
+    float x, y, z, mass;
+    std::uint64_t id;
+};
+
+void BM_RecordFieldScan(benchmark::State& state) {
+    Vector<Particle> particles;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        particles.push_back(Particle{float(i), 0, 0, 1, std::uint64_t(i)});
+    }
+    for (auto _ : state) {
+        float sum = 0;
+        for (const Particle& p : particles) {
+            sum += p.x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SoAFieldScan(benchmark::State& state) {
+    SoAVector<float, float, float, float, std::uint64_t> particles;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        particles.emplace_back(float(i), 0.0f, 0.0f, 1.0f, std::uint64_t(i));
+    }
+    for (auto _ : state) {
+        float sum = 0;
+        for (const float x : particles.column<0>()) {
+            sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_RecordFieldScan)->Apply(element_sizes<Particle>);
+BENCHMARK(BM_SoAFieldScan)->Apply(element_sizes<Particle>);
+
+// Reverse scan of a time series, newest sample first
+template <typename Container>
+void BM_ReverseScan(benchmark::State& state) {
+    const Container c = make_filled<Container>(state.range(0));
+    for (auto _ : state) {
+        int sum = 0;
+        for (auto it = c.rbegin(); it != c.rend(); ++it) {
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_items<Container>(state);
+}
+
+VECTOR_BENCHMARK(BM_ReverseScan, int);
+
+// Read-mostly tables handed to readers: a deep copy against a shared frozen snapshot
+void BM_SnapshotDeepCopy(benchmark::State& state) {
+    const Vector<std::string> table = make_filled<Vector<std::string>>(state.range(0));
+    for (auto _ : state) {
+        Vector<std::string> snapshot(table);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SnapshotFrozen(benchmark::State& state) {
+    const FrozenVector<std::string> table = freeze(make_filled<Vector<std::string>>(state.range(0)));
+    for (auto _ : state) {
+        FrozenVector<std::string> snapshot(table);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SnapshotDeepCopy)->Apply(element_sizes<std::string>);
+BENCHMARK(BM_SnapshotFrozen)->Apply(element_sizes<std::string>);
+
+// Sorted dictionaries: building from one unsorted batch, then looking every key up
+std::vector<std::pair<std::uint64_t, std::uint64_t>> make_entries(const size_t n) {
+    std::mt19937_64 rng(42);
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> entries(n);
+    for (auto& [key, value] : entries) {
+        key = rng();
+        value = key / 2;
+    }
+    return entries;
+}
+
+template <typename Map>
+void BM_MapBuild(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+    for (auto _ : state) {
+        Map map;
+        if constexpr (requires { map.bulk_insert(entries); }) {
+            map.bulk_insert(entries);
+        } else {
+            map.insert(entries.begin(), entries.end());
+        }
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+void BM_MapFind(benchmark::State& state) {
+    const auto entries = make_entries(state.range(0));
+    Map map;
+    if constexpr (requires { map.bulk_insert(entries); }) {
+        map.bulk_insert(entries);
+    } else {
+        map.insert(entries.begin(), entries.end());
+    }
+    for (auto _ : state) {
+        std::uint64_t found = 0;
+        for (const auto& entry : entries) {
+            found += map.find(entry.first) != map.end();
+        }
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using FlatMap64 = FlatMap<std::uint64_t, std::uint64_t>;
+using StdMap64 = std::map<std::uint64_t, std::uint64_t>;
+BENCHMARK_TEMPLATE(BM_MapBuild, FlatMap64)->RangeMultiplier(10)->Range(10, 1'000'000);
+BENCHMARK_TEMPLATE(BM_MapBuild, StdMap64)->RangeMultiplier(10)->Range(10, 1'000'000);
+BENCHMARK_TEMPLATE(BM_MapFind, FlatMap64)->RangeMultiplier(10)->Range(10, 1'000'000);
+BENCHMARK_TEMPLATE(BM_MapFind, StdMap64)->RangeMultiplier(10)->Range(10, 1'000'000);
+
+// Checking policies: draining a vector as a stack, where every back() and pop_back() is checked
+template <typename Container>
+void BM_StackDrain(benchmark::State& state) {
+    Container c;
+    for (auto _ : state) {
+        state.PauseTiming();
+        c.assign(state.range(0), 1);
+        state.ResumeTiming();
+        int sum = 0;
+        while (!c.empty()) {
+            sum += c.back();
+            c.pop_back();
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using UncheckedVector = Vector<int, DefaultAllocator<int>, 0, DoublingGrowth, NoStats, Unchecked>;
+BENCHMARK_TEMPLATE(BM_StackDrain, Vector<int>)->Apply(element_sizes<int>);
+BENCHMARK_TEMPLATE(BM_StackDrain, UncheckedVector)->Apply(element_sizes<int>);
+
+// Filtering pass dropping every third element: one compaction against an erase per element
+void BM_FilterEraseIf(benchmark::State& state) {
+    Vector<int> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v.assign(state.range(0), 0);
+        std::iota(v.begin(), v.end(), 0);
+        state.ResumeTiming();
+        erase_if(v, [](const int x) { return x % 3 == 0; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_FilterRepeatedErase(benchmark::State& state) {
+    Vector<int> v;
+    for (auto _ : state) {
+        state.PauseTiming();
+        v.assign(state.range(0), 0);
+        std::iota(v.begin(), v.end(), 0);
+        state.ResumeTiming();
+        for (auto it = v.begin(); it != v.end();) {
+            if (*it % 3 == 0) {
+                v.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_FilterEraseIf)->RangeMultiplier(10)->Range(10, 100'000);
+BENCHMARK(BM_FilterRepeatedErase)->RangeMultiplier(10)->Range(10, 100'000);
+
+// Flag Masks
+// Packed bits against one byte per flag, for counting and intersecting masks
+void BM_BitVectorCount(benchmark::State& state) {
+    BitVector<> flags(state.range(0));
+    for (int64_t i = 0; i < state.range(0); i += 3) flags[i] = true;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(flags.count());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ByteFlagsCount(benchmark::State& state) {
+    Vector<bool> flags;
+    flags.resize(state.range(0), false);
+    for (int64_t i = 0; i < state.range(0); i += 3) flags[i] = true;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::count(flags.begin(), flags.end(), true));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BitVectorAnd(benchmark::State& state) {
+    BitVector<> a(state.range(0), true);
+    const BitVector<> b(state.range(0), true);
+    for (auto _ : state) {
+        a &= b;
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_ByteFlagsAnd(benchmark::State& state) {
+    Vector<bool> a, b;
+    a.resize(state.range(0), true);
+    b.resize(state.range(0), true);
+    for (auto _ : state) {
+        for (size_t i = 0; i < a.size(); ++i) {
+            a[i] = a[i] && b[i];
+        }
+        benchmark::DoNotOptimize(a.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_BitVectorCount)->RangeMultiplier(100)->Range(100, 100'000'000);
+BENCHMARK(BM_ByteFlagsCount)->RangeMultiplier(100)->Range(100, 100'000'000);
+BENCHMARK(BM_BitVectorAnd)->RangeMultiplier(100)->Range(100, 100'000'000);
+BENCHMARK(BM_ByteFlagsAnd)->RangeMultiplier(100)->Range(100, 100'000'000);
+
+// Streaming Stores
+// Copies and assign(count, value) of range(0) bytes, with streaming stores forced on
+// (range(1) == 1) or off, to find where they start to pay off. A hot set is re-read after each
+// transfer, so the cost of the evictions the transfer caused is counted too.
+template <typename Transfer>
+void streaming_benchmark(benchmark::State& state, Transfer&& transfer) {
+    const size_t saved_copy = StreamHelper::copy_threshold();
+    const size_t saved_fill = StreamHelper::fill_threshold();
+    StreamHelper::set_copy_threshold(state.range(1) ? 0 : SIZE_MAX);
+    StreamHelper::set_fill_threshold(state.range(1) ? 0 : SIZE_MAX);
+    const Vector<std::uint64_t> hot(size_t(1) << 17, 1);
+    for (auto _ : state) {
+        transfer();
+        std::uint64_t sum = 0;
+        for (const std::uint64_t x : hot) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+    StreamHelper::set_copy_threshold(saved_copy);
+    StreamHelper::set_fill_threshold(saved_fill);
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Copy assignment into a buffer that is already mapped, so page faults do not hide the stores
+void BM_StreamingCopy(benchmark::State& state) {
+    const Vector<std::uint64_t> source(state.range(0) / sizeof(std::uint64_t), 7);
+    Vector<std::uint64_t> target(source.size(), 0);
+    streaming_benchmark(state, [&source, &target] {
+        target = source;
+        benchmark::DoNotOptimize(target.data());
+    });
+}
+
+void BM_StreamingFill(benchmark::State& state) {
+    Vector<std::uint64_t> target(state.range(0) / sizeof(std::uint64_t), 0);
+    streaming_benchmark(state, [&target, &state] {
+        target.assign(state.range(0) / sizeof(std::uint64_t), 7);
+        benchmark::DoNotOptimize(target.data());
+    });
+}
+
+BENCHMARK(BM_StreamingCopy)->ArgsProduct({benchmark::CreateRange(1 << 18, 1 << 28, 4), {0, 1}})->UseRealTime();
+BENCHMARK(BM_StreamingFill)->ArgsProduct({benchmark::CreateRange(1 << 18, 1 << 28, 4), {0, 1}})->UseRealTime();
+
+// Range Adapters
+// vector_adapters against the equivalent hand-written std::vector loop
+void BM_AdapterToVector(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto v = vector_adapters::to_vector(std::views::iota(0, n));
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdToVector(benchmark::State& state) {
+    const int n = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (int i : std::views::iota(0, n)) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AdapterTransformToVector(benchmark::State& state) {
+    const std::vector<int> source = make_filled<std::vector<int>>(state.range(0));
+    for (auto _ : state) {
+        auto v = vector_adapters::transform_to_vector(source, [](int x) { return x * 3 + 1; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdTransformToVector(benchmark::State& state) {
+    const std::vector<int> source = make_filled<std::vector<int>>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (int x : source | std::views::transform([](int x) { return x * 3 + 1; })) {
+            v.push_back(x);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AdapterFilterToVector(benchmark::State& state) {
+    const std::vector<int> source = make_filled<std::vector<int>>(state.range(0));
+    for (auto _ : state) {
+        auto v = vector_adapters::filter_to_vector(source, [](int x) { return x % 3 == 0; });
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_StdFilterToVector(benchmark::State& state) {
+    const std::vector<int> source = make_filled<std::vector<int>>(state.range(0));
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (int x : source | std::views::filter([](int x) { return x % 3 == 0; })) {
+            v.push_back(x);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_AdapterToVector)->Apply(element_sizes<int>);
+BENCHMARK(BM_StdToVector)->Apply(element_sizes<int>);
+BENCHMARK(BM_AdapterTransformToVector)->Apply(element_sizes<int>);
+BENCHMARK(BM_StdTransformToVector)->Apply(element_sizes<int>);
+BENCHMARK(BM_AdapterFilterToVector)->Apply(element_sizes<int>);
+BENCHMARK(BM_StdFilterToVector)->Apply(element_sizes<int>);
+
+BENCHMARK_MAIN();
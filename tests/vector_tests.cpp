@@ -0,0 +1,372 @@
+// Behaviour tests for Vector and the sibling containers: aliasing, rollback on throw, growth
+// counts, file round trips and the rules the benchmarks take for granted. Plain checks, no
+// framework; the exit status is the number of failed checks.
+//
+// Build and run from the repository root:
+//   g++ -std=c++20 -O1 -g -I. -fsanitize=address,undefined tests/vector_tests.cpp -lpthread -o vector_tests
+//   ./vector_tests
+
+#include "Vector.hpp"
+#include "BitVector.hpp"
+#include "ConcurrentVector.hpp"
+#include "FlatMap.hpp"
+#include "MappedVector.hpp"
+#include "VectorIO.hpp"
+#include "VectorStats.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <list>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                               \
+    do {                                                                               \
+        if (!(condition)) {                                                            \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++failures;                                                                \
+        }                                                                              \
+    } while (0)
+
+template <typename Exception, typename Func>
+static bool throws(Func&& func) {
+    try {
+        func();
+    } catch (const Exception&) {
+        return true;
+    }
+    return false;
+}
+
+static std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Element Types
+// Counts live objects and throws from the copy or move that exhausts the budget. Its moves are
+// not noexcept and it is not trivially relocatable, so every relocation runs user code.
+struct Fragile {
+    static inline int live = 0;
+    static inline int budget = -1;  // copies and moves left before one throws; -1 never throws
+
+    int value;
+    std::string padding;
+
+    static void spend() {
+        if (budget >= 0 && budget-- == 0) throw std::runtime_error("Fragile: budget exhausted");
+    }
+
+    Fragile(const int v = 0) : value(v) { ++live; }
+    Fragile(const Fragile& other) : value(other.value) {
+        spend();
+        ++live;
+    }
+    Fragile(Fragile&& other) : value(other.value) {
+        spend();
+        ++live;
+    }
+    Fragile& operator=(const Fragile& other) {
+        spend();
+        value = other.value;
+        return *this;
+    }
+    Fragile& operator=(Fragile&& other) {
+        spend();
+        value = other.value;
+        return *this;
+    }
+    ~Fragile() { --live; }
+};
+
+// Stateful allocator that propagates on swap; a move leaves the source with id -1, as the
+// allocator requirements allow
+template <typename T>
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_swap = std::true_type;
+
+    int id = 0;
+
+    TaggedAllocator(const int i = 0) noexcept : id(i) {}
+    TaggedAllocator(const TaggedAllocator&) noexcept = default;
+    TaggedAllocator& operator=(const TaggedAllocator&) noexcept = default;
+    TaggedAllocator(TaggedAllocator&& other) noexcept : id(other.id) { other.id = -1; }
+    TaggedAllocator& operator=(TaggedAllocator&& other) noexcept {
+        id = other.id;
+        other.id = -1;
+        return *this;
+    }
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U>& other) noexcept : id(other.id) {}
+
+    T* allocate(const size_t n) { return std::allocator<T>().allocate(n); }
+    void deallocate(T* p, const size_t n) { std::allocator<T>().deallocate(p, n); }
+    bool operator==(const TaggedAllocator& other) const noexcept { return id == other.id; }
+};
+
+// Aliasing
+// Arguments that refer to the vector's own elements must survive the reallocation they trigger
+static void test_aliasing() {
+    Vector<std::string> v;
+    v.push_back(std::string(40, 'a'));
+    for (int i = 0; i < 100; ++i) {
+        v.push_back(v[0]);
+        v.emplace_back(v.back());
+    }
+    CHECK(v.size() == 201);
+    CHECK(std::ranges::all_of(v, [](const std::string& s) { return s == std::string(40, 'a'); }));
+
+    v.insert(v.begin(), v.back());
+    v.insert(v.begin() + 3, 5, v[1]);
+    CHECK(v.size() == 207 && v[0] == v[206] && v[3] == v[1]);
+
+    SmallVector<std::string, 2> small;
+    small.push_back("first");
+    small.push_back(small[0]);
+    small.push_back(small[1]);  // leaves the inline buffer
+    CHECK(small.size() == 3 && small[2] == "first");
+}
+
+// Rollback on Throw
+// After any throw, every object the vector built is either counted by size() or destroyed
+static void test_rollback() {
+    Fragile::live = 0;
+    for (int budget = 0; budget < 12; ++budget) {
+        Fragile::budget = budget;
+        CHECK(throws<std::runtime_error>([] { Vector<Fragile> v(8, Fragile(1)); }) || budget >= 8);
+        Fragile::budget = -1;
+        CHECK(Fragile::live == 0);
+    }
+
+    for (int budget = 0; budget < 30; ++budget) {
+        for (size_t where = 0; where <= 6; ++where) {
+            for (const size_t count : {1u, 2u, 5u, 9u}) {
+                Vector<Fragile> source;
+                for (size_t i = 0; i < count; ++i) source.emplace_back(50 + static_cast<int>(i));
+                {
+                    Vector<Fragile> v;
+                    v.reserve(32);
+                    for (int i = 0; i < 6; ++i) v.emplace_back(i);
+
+                    Fragile::budget = budget;
+                    try {
+                        v.insert(v.begin() + where, count, Fragile(99));
+                    } catch (const std::runtime_error&) {
+                    }
+                    Fragile::budget = budget;
+                    try {
+                        v.insert(v.begin() + std::min(where, v.size()), source.begin(), source.end());
+                    } catch (const std::runtime_error&) {
+                    }
+                    Fragile::budget = budget;
+                    try {
+                        v.emplace_at(v.begin() + std::min(where, v.size()), 7);
+                    } catch (const std::runtime_error&) {
+                    }
+                    Fragile::budget = -1;
+                    CHECK(Fragile::live == static_cast<int>(v.size() + source.size()));
+                }
+                CHECK(Fragile::live == static_cast<int>(source.size()));
+            }
+        }
+    }
+
+    // A failed reallocation leaves the elements where they were
+    Vector<Fragile> v;
+    for (int i = 0; i < 4; ++i) v.emplace_back(i);
+    v.shrink_to_fit();
+    Fragile::budget = 2;
+    CHECK(throws<std::runtime_error>([&] { v.reserve(64); }));
+    Fragile::budget = -1;
+    CHECK(v.size() == 4 && v[3].value == 3 && Fragile::live == 4);
+
+    // So does a failed insertion that had to grow the buffer around its gap
+    for (int budget = 0; budget < 20; ++budget) {
+        Fragile::budget = budget;
+        const bool threw = throws<std::runtime_error>([&] { v.insert(v.begin() + 2, 3, Fragile(9)); });
+        Fragile::budget = -1;
+        CHECK(Fragile::live == static_cast<int>(v.size()));
+        if (!threw) break;
+        CHECK(v.size() == 4 && v[0].value == 0 && v[2].value == 2 && v[3].value == 3);
+    }
+}
+
+// Growth
+// A range of known length is appended with at most one reallocation
+static void test_append_range_growth() {
+    using Counted = Vector<int, DefaultAllocator<int>, 0, DoublingGrowth, VectorStats>;
+    const std::vector<int> sized(1000, 7);
+    const std::list<int> forward(500, 3);
+
+    Counted v;
+    for (int i = 0; i < 3; ++i) v.push_back(i);
+    size_t before = v.stats().counters().allocations;
+    v.append_range(sized);
+    CHECK(v.stats().counters().allocations - before <= 1);
+    before = v.stats().counters().allocations;
+    v.append_range(forward);
+    CHECK(v.stats().counters().allocations - before <= 1);
+    CHECK(v.size() == 1503 && v[2] == 2 && v[3] == 7 && v[1502] == 3);
+
+    // Single-pass input ranges, whose sentinel differs from the iterator, still insert in place
+    std::istringstream in("7 8 9");
+    v.insert_range(v.begin() + 1, std::views::istream<int>(in));
+    CHECK(v.size() == 1506 && v[0] == 0 && v[1] == 7 && v[3] == 9 && v[4] == 1);
+}
+
+static void test_swap_allocators() {
+    using Tagged = Vector<std::string, TaggedAllocator<std::string>, 2>;
+    for (const int left : {1, 5}) {
+        for (const int right : {1, 5}) {
+            Tagged a{TaggedAllocator<std::string>(1)};
+            Tagged b{TaggedAllocator<std::string>(2)};
+            for (int i = 0; i < left; ++i) a.push_back("a" + std::to_string(i));
+            for (int i = 0; i < right; ++i) b.push_back("b" + std::to_string(i));
+            a.swap(b);
+            CHECK(a.get_allocator().id == 2 && b.get_allocator().id == 1);
+            CHECK(static_cast<int>(a.size()) == right && a[0] == "b0");
+            CHECK(static_cast<int>(b.size()) == left && b[0] == "a0");
+        }
+    }
+}
+
+// File Formats
+static void test_vector_io() {
+    Vector<int> numbers;
+    for (int i = 0; i < 100000; ++i) numbers.push_back(i * 3);
+    Vector<std::string> words;
+    for (int i = 0; i < 1000; ++i) words.push_back(std::string(i % 50, static_cast<char>('a' + i % 26)));
+    Vector<Vector<int>> nested;
+    for (int i = 0; i < 20; ++i) nested.push_back(Vector<int>(i, i));
+
+    std::stringstream stream;
+    vector_io::write_to(stream, numbers);
+    vector_io::write_to(stream, words);
+    vector_io::write_to(stream, nested);
+    Vector<int> numbers_in;
+    Vector<std::string> words_in;
+    Vector<Vector<int>> nested_in;
+    vector_io::read_from(stream, numbers_in);
+    vector_io::read_from(stream, words_in);
+    vector_io::read_from(stream, nested_in);
+    CHECK(numbers_in == numbers && words_in == words && nested_in == nested);
+
+    const std::string path = temp_path("vector_tests_io.bin");
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    vector_io::write_to(fd, numbers);
+    ::close(fd);
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    Vector<int> appended;
+    appended.push_back(-1);
+    vector_io::read_from(fd, appended);  // appends after what the vector holds
+    CHECK(appended.size() == numbers.size() + 1 && appended[0] == -1 && appended[1] == 0);
+    ::close(fd);
+
+    fd = ::open(path.c_str(), O_RDONLY);
+    Vector<double> wrong_type;
+    CHECK(throws<std::runtime_error>([&] { vector_io::read_from(fd, wrong_type); }));
+    ::close(fd);
+    std::filesystem::remove(path);
+}
+
+static void test_mapped_vector() {
+    const std::string path = temp_path("vector_tests_mapped.bin");
+    std::filesystem::remove(path);
+    {
+        MappedVector<int> v(path);
+        for (int i = 0; i < 5; ++i) v.push_back(i);
+        for (int round = 0; round < 10; ++round) {
+            // Appending the vector to itself remaps the file under the source
+            v.append_range(std::span<const int>(v.data(), v.size()));
+        }
+        CHECK(v.size() == 5u << 10);
+    }
+    {
+        MappedVector<const int> reopened(path);
+        CHECK(reopened.size() == 5u << 10);
+        bool intact = true;
+        for (size_t i = 0; i < reopened.size(); ++i) intact = intact && reopened[i] == static_cast<int>(i % 5);
+        CHECK(intact);
+    }
+    CHECK(throws<std::runtime_error>([&] { MappedVector<double> wrong_type(path); }));
+    std::filesystem::remove(path);
+}
+
+// Sibling Containers
+static void test_flat_map() {
+    FlatMap<int, std::string> map;
+    map.insert(5, "kept");
+    const std::vector<std::pair<int, std::string>> batch{{3, "first"}, {5, "replaced"}, {3, "second"}, {1, "one"}};
+    map.bulk_insert(batch);
+    CHECK(map.size() == 3);
+    CHECK(map.at(3) == "first" && map.at(5) == "kept" && map.at(1) == "one");
+    CHECK(std::ranges::is_sorted(map.keys()));
+}
+
+static void test_concurrent_vector() {
+    ConcurrentVector<int> v;
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t) {
+        producers.emplace_back([&v] {
+            for (int i = 0; i < 10000; ++i) v.push_back(i);
+        });
+    }
+    for (std::thread& producer : producers) producer.join();
+    CHECK(v.size() == 40000);
+    long long sum = 0;
+    v.for_each([&sum](const int x) { sum += x; });
+    CHECK(sum == 4LL * 9999 * 10000 / 2);
+
+    // A claim the segment table cannot hold is refused without being counted
+    // GCC's -O2 range analysis cannot see that claim() throws first and flags the loop behind it
+    const size_t before = v.size();
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+#endif
+    CHECK(throws<std::bad_array_new_length>([&] { v.grow_by(static_cast<size_t>(-1) - before); }));
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+    CHECK(v.size() == before);
+}
+
+// Constant Evaluation
+constexpr auto squares = vector_adapters::to_array<[] {
+    Vector<int> table;
+    for (int i = 0; i < 16; ++i) table.push_back(i * i);
+    return table;
+}>();
+static_assert(squares[15] == 225);
+
+static_assert([] {
+    BitVector<> bits(200);
+    bits[3] = true;
+    bits[150] = true;
+    bits.push_back(true);
+    return bits.count();
+}() == 3);
+
+int main() {
+    test_aliasing();
+    test_rollback();
+    test_append_range_growth();
+    test_swap_allocators();
+    test_vector_io();
+    test_mapped_vector();
+    test_flat_map();
+    test_concurrent_vector();
+
+    if (failures == 0) std::puts("All tests passed");
+    return failures;
+}